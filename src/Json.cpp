@@ -6,929 +6,4294 @@
  * @brief Repo: https://github.com/CatIsNotFound/JsonBuilder
  */
 #include "Json.h"
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <io.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#define JSONBUILDER_POSIX_FILE
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if !defined(JSONBUILDER_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define JSONBUILDER_X86_SIMD
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define JSONBUILDER_TARGET_SSE2
+#define JSONBUILDER_TARGET_AVX2
+#else
+#define JSONBUILDER_TARGET_SSE2 __attribute__((target("sse2")))
+#define JSONBUILDER_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+    /// 结构索引（两遍解析的第一阶段）：以 64 字节为一块，按位标记引号、反斜杠、结构字符与空白字符
+    struct BlockMasks {
+        uint64_t quote;
+        uint64_t backslash;
+        uint64_t op;
+        uint64_t space;
+        uint64_t newline;
+    };
+
+    struct IndexState {
+        uint64_t next_escaped{0};
+        uint64_t in_string{0};
+        uint64_t prev_scalar{0};
+        size_t string_newline{std::string_view::npos};
+    };
+
+    constexpr size_t BLOCK_SIZE = 64;
+
+    inline uint64_t prefixXor(uint64_t bits) {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    /// 处理一个已分类的块：去除被转义的引号，计算字符串区间，并将结构字符、引号与标量起始位置写入索引
+    inline void indexBlock(const BlockMasks &masks, size_t base, IndexState &state, std::vector<uint32_t> &index) {
+        constexpr uint64_t ODD_BITS = 0xAAAAAAAAAAAAAAAAULL;
+        uint64_t escaped;
+        if (masks.backslash == 0) {
+            escaped = state.next_escaped;
+            state.next_escaped = 0;
+        } else {
+            uint64_t potential_escape = masks.backslash & ~state.next_escaped;
+            uint64_t maybe_escaped = potential_escape << 1;
+            uint64_t escape_and_terminal = ((maybe_escaped | ODD_BITS) - potential_escape) ^ ODD_BITS;
+            escaped = escape_and_terminal ^ (masks.backslash | state.next_escaped);
+            state.next_escaped = (escape_and_terminal & masks.backslash) >> 63;
+        }
+        uint64_t quote = masks.quote & ~escaped;
+        uint64_t in_string = prefixXor(quote) ^ state.in_string;
+        state.in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+        uint64_t string_newline = masks.newline & in_string;
+        if (string_newline && state.string_newline == std::string_view::npos) {
+            state.string_newline = base + std::countr_zero(string_newline);
+        }
+        uint64_t scalar = ~(in_string | quote | masks.op | masks.space);
+        uint64_t scalar_start = scalar & ~((scalar << 1) | state.prev_scalar);
+        state.prev_scalar = scalar >> 63;
+
+        uint64_t bits = (masks.op & ~in_string) | quote | scalar_start;
+        if (!bits) return;
+        size_t count = std::popcount(bits);
+        size_t old_size = index.size();
+        index.resize(old_size + count);
+        uint32_t *out = index.data() + old_size;
+        while (bits) {
+            *out++ = static_cast<uint32_t>(base + std::countr_zero(bits));
+            bits &= bits - 1;
+        }
+    }
+
+    /// 不足 64 字节的尾块以空格补齐
+    inline const char *tailBlock(std::string_view json, size_t base, char *buffer) {
+        std::memset(buffer, ' ', BLOCK_SIZE);
+        std::memcpy(buffer, json.data() + base, json.size() - base);
+        return buffer;
+    }
+
+    BlockMasks classifyScalar(const char *block) {
+        BlockMasks masks{0, 0, 0, 0, 0};
+        for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+            uint64_t bit = uint64_t(1) << i;
+            switch (block[i]) {
+                case '"': masks.quote |= bit; break;
+                case '\\': masks.backslash |= bit; break;
+                case '{': case '}': case '[': case ']': case ',': case ':': masks.op |= bit; break;
+                case '\n': masks.newline |= bit; masks.space |= bit; break;
+                case ' ': case '\t': case '\r': masks.space |= bit; break;
+                default: break;
+            }
+        }
+        return masks;
+    }
+
+    void indexScalar(std::string_view json, IndexState &state, std::vector<uint32_t> &index) {
+        char buffer[BLOCK_SIZE];
+        for (size_t base = 0; base < json.size(); base += BLOCK_SIZE) {
+            const char *block = (json.size() - base >= BLOCK_SIZE) ? json.data() + base : tailBlock(json, base, buffer);
+            indexBlock(classifyScalar(block), base, state, index);
+        }
+    }
+
+#ifdef JSONBUILDER_X86_SIMD
+    JSONBUILDER_TARGET_SSE2 inline uint64_t bits(__m128i mask) {
+        return static_cast<uint32_t>(_mm_movemask_epi8(mask));
+    }
+
+    JSONBUILDER_TARGET_SSE2 inline BlockMasks classifySse2(const char *block) {
+        const __m128i quote = _mm_set1_epi8('"'), backslash = _mm_set1_epi8('\\');
+        const __m128i lbrace = _mm_set1_epi8('{'), rbrace = _mm_set1_epi8('}');
+        const __m128i lbracket = _mm_set1_epi8('['), rbracket = _mm_set1_epi8(']');
+        const __m128i comma = _mm_set1_epi8(','), colon = _mm_set1_epi8(':');
+        const __m128i space = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t');
+        const __m128i newline = _mm_set1_epi8('\n'), carriage = _mm_set1_epi8('\r');
+        BlockMasks masks{0, 0, 0, 0, 0};
+        for (int i = 0; i < 4; ++i) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i * 16));
+            int shift = i * 16;
+            __m128i op = _mm_or_si128(
+                    _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, lbrace), _mm_cmpeq_epi8(v, rbrace)),
+                                 _mm_or_si128(_mm_cmpeq_epi8(v, lbracket), _mm_cmpeq_epi8(v, rbracket))),
+                    _mm_or_si128(_mm_cmpeq_epi8(v, comma), _mm_cmpeq_epi8(v, colon)));
+            __m128i line = _mm_cmpeq_epi8(v, newline);
+            __m128i blank = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+                                         _mm_or_si128(line, _mm_cmpeq_epi8(v, carriage)));
+            masks.quote |= bits(_mm_cmpeq_epi8(v, quote)) << shift;
+            masks.backslash |= bits(_mm_cmpeq_epi8(v, backslash)) << shift;
+            masks.op |= bits(op) << shift;
+            masks.space |= bits(blank) << shift;
+            masks.newline |= bits(line) << shift;
+        }
+        return masks;
+    }
+
+    JSONBUILDER_TARGET_SSE2 void indexSse2(std::string_view json, IndexState &state, std::vector<uint32_t> &index) {
+        char buffer[BLOCK_SIZE];
+        for (size_t base = 0; base < json.size(); base += BLOCK_SIZE) {
+            const char *block = (json.size() - base >= BLOCK_SIZE) ? json.data() + base : tailBlock(json, base, buffer);
+            indexBlock(classifySse2(block), base, state, index);
+        }
+    }
+
+    JSONBUILDER_TARGET_AVX2 inline uint64_t bits(__m256i mask) {
+        return static_cast<uint32_t>(_mm256_movemask_epi8(mask));
+    }
+
+    JSONBUILDER_TARGET_AVX2 inline BlockMasks classifyAvx2(const char *block) {
+        const __m256i quote = _mm256_set1_epi8('"'), backslash = _mm256_set1_epi8('\\');
+        const __m256i lbrace = _mm256_set1_epi8('{'), rbrace = _mm256_set1_epi8('}');
+        const __m256i lbracket = _mm256_set1_epi8('['), rbracket = _mm256_set1_epi8(']');
+        const __m256i comma = _mm256_set1_epi8(','), colon = _mm256_set1_epi8(':');
+        const __m256i space = _mm256_set1_epi8(' '), tab = _mm256_set1_epi8('\t');
+        const __m256i newline = _mm256_set1_epi8('\n'), carriage = _mm256_set1_epi8('\r');
+        BlockMasks masks{0, 0, 0, 0, 0};
+        for (int i = 0; i < 2; ++i) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + i * 32));
+            int shift = i * 32;
+            __m256i op = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, lbrace), _mm256_cmpeq_epi8(v, rbrace)),
+                                    _mm256_or_si256(_mm256_cmpeq_epi8(v, lbracket), _mm256_cmpeq_epi8(v, rbracket))),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, comma), _mm256_cmpeq_epi8(v, colon)));
+            __m256i line = _mm256_cmpeq_epi8(v, newline);
+            __m256i blank = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab)),
+                                            _mm256_or_si256(line, _mm256_cmpeq_epi8(v, carriage)));
+            masks.quote |= bits(_mm256_cmpeq_epi8(v, quote)) << shift;
+            masks.backslash |= bits(_mm256_cmpeq_epi8(v, backslash)) << shift;
+            masks.op |= bits(op) << shift;
+            masks.space |= bits(blank) << shift;
+            masks.newline |= bits(line) << shift;
+        }
+        return masks;
+    }
+
+    JSONBUILDER_TARGET_AVX2 void indexAvx2(std::string_view json, IndexState &state, std::vector<uint32_t> &index) {
+        char buffer[BLOCK_SIZE];
+        for (size_t base = 0; base < json.size(); base += BLOCK_SIZE) {
+            const char *block = (json.size() - base >= BLOCK_SIZE) ? json.data() + base : tailBlock(json, base, buffer);
+            indexBlock(classifyAvx2(block), base, state, index);
+        }
+    }
+
+    bool cpuSupportsAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        bool os_saves_ymm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 6) == 6);
+        __cpuidex(info, 7, 0);
+        return os_saves_ymm && (info[1] & (1 << 5));
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    bool cpuSupportsSse2() {
+#if defined(__x86_64__) || defined(_M_X64) || (defined(_MSC_VER) && !defined(__clang__))
+        return true;
+#else
+        return __builtin_cpu_supports("sse2");
+#endif
+    }
+#endif
+
+    using IndexFunction = void (*)(std::string_view, IndexState &, std::vector<uint32_t> &);
+    using StringScanFunction = size_t (*)(const char *, size_t, size_t);
+
+    enum class SimdLevel {
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    /// 运行时按 CPU 支持情况选择实现；可通过环境变量 JSONBUILDER_SIMD=scalar|sse2|avx2 强制指定（不超过 CPU 支持的范围）
+    SimdLevel simdLevel() {
+#ifdef JSONBUILDER_X86_SIMD
+        const char *forced = std::getenv("JSONBUILDER_SIMD");
+        std::string_view level = forced ? forced : "";
+        if (level == "scalar") return SimdLevel::Scalar;
+        if (cpuSupportsAvx2() && level != "sse2") return SimdLevel::Avx2;
+        if (cpuSupportsSse2()) return SimdLevel::Sse2;
+#endif
+        return SimdLevel::Scalar;
+    }
+
+    IndexFunction selectIndexFunction() {
+        switch (simdLevel()) {
+#ifdef JSONBUILDER_X86_SIMD
+            case SimdLevel::Avx2: return indexAvx2;
+            case SimdLevel::Sse2: return indexSse2;
+#endif
+            default: return indexScalar;
+        }
+    }
+
+    /// 字符串扫描：返回 [pos, size) 中第一个 '"'、'\\' 或 '\n' 的位置，不存在时返回 size
+    size_t findStringSpecialScalar(const char *data, size_t pos, size_t size) {
+        for (; pos < size; ++pos) {
+            char c = data[pos];
+            if (c == '"' || c == '\\' || c == '\n') break;
+        }
+        return pos;
+    }
+
+#ifdef JSONBUILDER_X86_SIMD
+    JSONBUILDER_TARGET_SSE2 size_t findStringSpecialSse2(const char *data, size_t pos, size_t size) {
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i newline = _mm_set1_epi8('\n');
+        for (; pos + 16 <= size; pos += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+            __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                       _mm_cmpeq_epi8(v, newline));
+            auto mask = static_cast<uint32_t>(_mm_movemask_epi8(hit));
+            if (mask) return pos + std::countr_zero(mask);
+        }
+        return findStringSpecialScalar(data, pos, size);
+    }
+
+    JSONBUILDER_TARGET_AVX2 size_t findStringSpecialAvx2(const char *data, size_t pos, size_t size) {
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i newline = _mm256_set1_epi8('\n');
+        for (; pos + 32 <= size; pos += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos));
+            __m256i hit = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote),
+                                                          _mm256_cmpeq_epi8(v, backslash)),
+                                          _mm256_cmpeq_epi8(v, newline));
+            auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+            if (mask) return pos + std::countr_zero(mask);
+        }
+        /// 尾部交给非 VEX 编码的 SSE2 版本前先清空 YMM 高位，避免 AVX/SSE 切换惩罚
+        _mm256_zeroupper();
+        return findStringSpecialSse2(data, pos, size);
+    }
+#endif
+
+    StringScanFunction selectStringScanFunction() {
+        switch (simdLevel()) {
+#ifdef JSONBUILDER_X86_SIMD
+            case SimdLevel::Avx2: return findStringSpecialAvx2;
+            case SimdLevel::Sse2: return findStringSpecialSse2;
+#endif
+            default: return findStringSpecialScalar;
+        }
+    }
+
+    size_t findStringSpecial(const char *data, size_t pos, size_t size) {
+        static const StringScanFunction scan = selectStringScanFunction();
+        return scan(data, pos, size);
+    }
+
+    /// 序列化时的转义扫描：返回 [pos, size) 中第一个 '"'、'\\' 或控制字符（小于 0x20）的位置，不存在时返回 size
+    size_t findEscapeScalar(const char *data, size_t pos, size_t size) {
+        for (; pos < size; ++pos) {
+            auto c = static_cast<unsigned char>(data[pos]);
+            if (c == '"' || c == '\\' || c < 0x20) break;
+        }
+        return pos;
+    }
+
+#ifdef JSONBUILDER_X86_SIMD
+    /// 无符号比较 c <= 0x1F 以 max(c, 0x1F) == 0x1F 实现，不会把 0x80 以上的 UTF-8 字节误判为控制字符
+    JSONBUILDER_TARGET_SSE2 size_t findEscapeSse2(const char *data, size_t pos, size_t size) {
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i control = _mm_set1_epi8(0x1F);
+        for (; pos + 16 <= size; pos += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+            __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                       _mm_cmpeq_epi8(_mm_max_epu8(v, control), control));
+            auto mask = static_cast<uint32_t>(_mm_movemask_epi8(hit));
+            if (mask) return pos + std::countr_zero(mask);
+        }
+        return findEscapeScalar(data, pos, size);
+    }
+
+    JSONBUILDER_TARGET_AVX2 size_t findEscapeAvx2(const char *data, size_t pos, size_t size) {
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i control = _mm256_set1_epi8(0x1F);
+        for (; pos + 32 <= size; pos += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos));
+            __m256i hit = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote),
+                                                          _mm256_cmpeq_epi8(v, backslash)),
+                                          _mm256_cmpeq_epi8(_mm256_max_epu8(v, control), control));
+            auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+            if (mask) return pos + std::countr_zero(mask);
+        }
+        _mm256_zeroupper();
+        return findEscapeSse2(data, pos, size);
+    }
+#endif
+
+    StringScanFunction selectEscapeScanFunction() {
+        switch (simdLevel()) {
+#ifdef JSONBUILDER_X86_SIMD
+            case SimdLevel::Avx2: return findEscapeAvx2;
+            case SimdLevel::Sse2: return findEscapeSse2;
+#endif
+            default: return findEscapeScalar;
+        }
+    }
+
+    size_t findEscape(const char *data, size_t pos, size_t size) {
+        static const StringScanFunction scan = selectEscapeScanFunction();
+        return scan(data, pos, size);
+    }
+
+    /// 整数和以 128 位精确累加：low 按 uint64 回绕，high 记录进位与负数的符号扩展，
+    /// 结果与运算顺序无关，转换为 double 时才舍入一次
+    struct WideSum {
+        uint64_t low;
+        int64_t high;
+
+        void add(uint64_t low_part, int64_t high_part) {
+            uint64_t previous = low;
+            low += low_part;
+            high += high_part + (low < previous ? 1 : 0);
+        }
+
+        void add(int64_t value) { add(static_cast<uint64_t>(value), value < 0 ? -1 : 0); }
+
+        [[nodiscard]] double value() const {
+            auto narrow = static_cast<int64_t>(low);
+            if (high == (narrow < 0 ? -1 : 0)) return static_cast<double>(narrow);
+            return std::ldexp(static_cast<double>(high), 64) + static_cast<double>(low);
+        }
+    };
+
+    /// 数值归约：一次遍历同时求和、最小值与最大值
+    struct IntegerSummary {
+        WideSum sum;
+        int64_t min;
+        int64_t max;
+    };
+
+    struct RealSummary {
+        double sum;
+        double min;
+        double max;
+    };
+
+    using IntegerReduceFunction = IntegerSummary (*)(const int64_t *, size_t);
+    using RealReduceFunction = RealSummary (*)(const double *, size_t);
+
+    IntegerSummary reduceIntegersScalar(const int64_t *data, size_t size) {
+        WideSum sum{0, 0};
+        int64_t low = std::numeric_limits<int64_t>::max(), high = std::numeric_limits<int64_t>::min();
+        for (size_t i = 0; i < size; ++i) {
+            sum.add(data[i]);
+            low = std::min(low, data[i]);
+            high = std::max(high, data[i]);
+        }
+        return {sum, low, high};
+    }
+
+    /// 浮点数以 8 路交错累加，按固定顺序合并后再依次加上尾部元素，
+    /// 因此各实现的结果逐位一致
+    RealSummary finishReals(RealSummary summary, const double *data, size_t pos, size_t size) {
+        for (; pos < size; ++pos) {
+            summary.sum += data[pos];
+            summary.min = std::min(summary.min, data[pos]);
+            summary.max = std::max(summary.max, data[pos]);
+        }
+        return summary;
+    }
+
+    RealSummary reduceRealsScalar(const double *data, size_t size) {
+        double lanes[8] = {};
+        double low = std::numeric_limits<double>::infinity(), high = -low;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            for (size_t k = 0; k < 8; ++k) {
+                lanes[k] += data[i + k];
+                low = std::min(low, data[i + k]);
+                high = std::max(high, data[i + k]);
+            }
+        }
+        double sum = ((lanes[0] + lanes[4]) + (lanes[2] + lanes[6])) + ((lanes[1] + lanes[5]) + (lanes[3] + lanes[7]));
+        return finishReals({sum, low, high}, data, i, size);
+    }
+
+#ifdef JSONBUILDER_X86_SIMD
+    JSONBUILDER_TARGET_SSE2 RealSummary reduceRealsSse2(const double *data, size_t size) {
+        __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd(), s2 = _mm_setzero_pd(), s3 = _mm_setzero_pd();
+        __m128d low = _mm_set1_pd(std::numeric_limits<double>::infinity());
+        __m128d high = _mm_set1_pd(-std::numeric_limits<double>::infinity());
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            __m128d v0 = _mm_loadu_pd(data + i), v1 = _mm_loadu_pd(data + i + 2);
+            __m128d v2 = _mm_loadu_pd(data + i + 4), v3 = _mm_loadu_pd(data + i + 6);
+            s0 = _mm_add_pd(s0, v0);
+            s1 = _mm_add_pd(s1, v1);
+            s2 = _mm_add_pd(s2, v2);
+            s3 = _mm_add_pd(s3, v3);
+            low = _mm_min_pd(low, _mm_min_pd(_mm_min_pd(v0, v1), _mm_min_pd(v2, v3)));
+            high = _mm_max_pd(high, _mm_max_pd(_mm_max_pd(v0, v1), _mm_max_pd(v2, v3)));
+        }
+        double sums[2], lows[2], highs[2];
+        _mm_storeu_pd(sums, _mm_add_pd(_mm_add_pd(s0, s2), _mm_add_pd(s1, s3)));
+        _mm_storeu_pd(lows, low);
+        _mm_storeu_pd(highs, high);
+        return finishReals({sums[0] + sums[1], std::min(lows[0], lows[1]), std::max(highs[0], highs[1])},
+                           data, i, size);
+    }
+
+    JSONBUILDER_TARGET_AVX2 RealSummary reduceRealsAvx2(const double *data, size_t size) {
+        __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+        __m256d low = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+        __m256d high = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            __m256d v0 = _mm256_loadu_pd(data + i), v1 = _mm256_loadu_pd(data + i + 4);
+            s0 = _mm256_add_pd(s0, v0);
+            s1 = _mm256_add_pd(s1, v1);
+            low = _mm256_min_pd(low, _mm256_min_pd(v0, v1));
+            high = _mm256_max_pd(high, _mm256_max_pd(v0, v1));
+        }
+        __m256d s = _mm256_add_pd(s0, s1);
+        double sums[2], lows[4], highs[4];
+        _mm_storeu_pd(sums, _mm_add_pd(_mm256_castpd256_pd128(s), _mm256_extractf128_pd(s, 1)));
+        _mm256_storeu_pd(lows, low);
+        _mm256_storeu_pd(highs, high);
+        return finishReals({sums[0] + sums[1], std::min(std::min(lows[0], lows[1]), std::min(lows[2], lows[3])),
+                            std::max(std::max(highs[0], highs[1]), std::max(highs[2], highs[3]))},
+                           data, i, size);
+    }
+
+    /// SSE2 没有 64 位整数比较，整数只提供 AVX2 实现
+    /// 每路各自维护 128 位和：无符号进位通过翻转符号位后的有符号比较得到
+    JSONBUILDER_TARGET_AVX2 IntegerSummary reduceIntegersAvx2(const int64_t *data, size_t size) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i sign = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+        __m256i sum = zero;
+        __m256i carry = zero;
+        __m256i low = _mm256_set1_epi64x(std::numeric_limits<int64_t>::max());
+        __m256i high = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+            __m256i next = _mm256_add_epi64(sum, v);
+            /// 回绕时 next < sum（无符号）；比较结果为 -1，因此减去；负数的符号扩展为 -1，因此加上
+            __m256i wrapped = _mm256_cmpgt_epi64(_mm256_xor_si256(sum, sign), _mm256_xor_si256(next, sign));
+            carry = _mm256_add_epi64(_mm256_sub_epi64(carry, wrapped), _mm256_cmpgt_epi64(zero, v));
+            sum = next;
+            low = _mm256_blendv_epi8(low, v, _mm256_cmpgt_epi64(low, v));
+            high = _mm256_blendv_epi8(high, v, _mm256_cmpgt_epi64(v, high));
+        }
+        int64_t sums[4], carries[4], lows[4], highs[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(sums), sum);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(carries), carry);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(lows), low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(highs), high);
+        IntegerSummary tail = reduceIntegersScalar(data + i, size - i);
+        for (int k = 0; k < 4; ++k) {
+            tail.sum.add(static_cast<uint64_t>(sums[k]), carries[k]);
+            tail.min = std::min(tail.min, lows[k]);
+            tail.max = std::max(tail.max, highs[k]);
+        }
+        return tail;
+    }
+#endif
+
+    IntegerReduceFunction selectIntegerReduceFunction() {
+        switch (simdLevel()) {
+#ifdef JSONBUILDER_X86_SIMD
+            case SimdLevel::Avx2: return reduceIntegersAvx2;
+#endif
+            default: return reduceIntegersScalar;
+        }
+    }
+
+    RealReduceFunction selectRealReduceFunction() {
+        switch (simdLevel()) {
+#ifdef JSONBUILDER_X86_SIMD
+            case SimdLevel::Avx2: return reduceRealsAvx2;
+            case SimdLevel::Sse2: return reduceRealsSse2;
+#endif
+            default: return reduceRealsScalar;
+        }
+    }
+
+    IntegerSummary reduceIntegers(std::span<const int64_t> data) {
+        static const IntegerReduceFunction reduce = selectIntegerReduceFunction();
+        return reduce(data.data(), data.size());
+    }
+
+    RealSummary reduceReals(std::span<const double> data) {
+        static const RealReduceFunction reduce = selectRealReduceFunction();
+        return reduce(data.data(), data.size());
+    }
+
+    bool readHex4(std::string_view text, size_t pos, uint32_t &code) {
+        if (pos + 4 > text.size()) return false;
+        code = 0;
+        for (size_t i = pos; i < pos + 4; ++i) {
+            char c = text[i];
+            code <<= 4;
+            if (c >= '0' && c <= '9') code |= static_cast<uint32_t>(c - '0');
+            else if (c >= 'a' && c <= 'f') code |= static_cast<uint32_t>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') code |= static_cast<uint32_t>(c - 'A' + 10);
+            else return false;
+        }
+        return true;
+    }
+
+    template<typename Output>
+    void appendUtf8(Output &out, uint32_t code) {
+        if (code < 0x80) {
+            out.push_back(static_cast<char>(code));
+        } else if (code < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else if (code < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+    }
+
+    /// 原地反转义时的输出：写入位置始终不超过读取位置（每个有效转义序列的输出都不长于其本身）
+    struct InPlaceOutput {
+        char *data;
+        size_t size;
+
+        void append(const char *text, size_t length) {
+            if (data + size != text) std::memmove(data + size, text, length);
+            size += length;
+        }
+        void push_back(char c) { data[size++] = c; }
+    };
+
+    /// 将字符串内容（不含两端引号）反转义后追加到 out：无转义的片段整段复制，\uXXXX（含代理对）转换为 UTF-8，
+    /// 不成对的代理项替换为 U+FFFD。返回第一个无效 \u 转义的位置，全部有效时返回 npos；
+    /// stop_on_error 为 true 时遇到无效转义立即返回（原地反转义必须如此，否则写入的 U+FFFD 可能超过读取位置）
+    template<typename Output>
+    size_t unescapeTo(std::string_view raw, Output &out, bool stop_on_error) {
+        size_t error = std::string_view::npos;
+        size_t pos = 0;
+        while (true) {
+            size_t slash = raw.find('\\', pos);
+            if (slash == std::string_view::npos) {
+                out.append(raw.data() + pos, raw.size() - pos);
+                return error;
+            }
+            out.append(raw.data() + pos, slash - pos);
+            if (slash + 1 >= raw.size()) return error;
+            pos = slash + 2;
+            switch (raw[slash + 1]) {
+                case '"': out.push_back('"'); break;
+                case '\\': out.push_back('\\'); break;
+                case '/': out.push_back('/'); break;
+                case '\'': out.push_back('\''); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'n': out.push_back('\n'); break;
+                case 'r': out.push_back('\r'); break;
+                case 't': out.push_back('\t'); break;
+                case 'u': {
+                    uint32_t code, low;
+                    if (!readHex4(raw, pos, code)) {
+                        if (error == std::string_view::npos) error = slash;
+                        if (stop_on_error) return error;
+                        appendUtf8(out, 0xFFFD);
+                        break;
+                    }
+                    pos += 4;
+                    if (code >= 0xD800 && code <= 0xDBFF) {
+                        if (pos + 6 <= raw.size() && raw[pos] == '\\' && raw[pos + 1] == 'u' &&
+                            readHex4(raw, pos + 2, low) && low >= 0xDC00 && low <= 0xDFFF) {
+                            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                            pos += 6;
+                        } else {
+                            code = 0xFFFD;
+                        }
+                    } else if (code >= 0xDC00 && code <= 0xDFFF) {
+                        code = 0xFFFD;
+                    }
+                    appendUtf8(out, code);
+                    break;
+                }
+                default:
+                    /// 其他转义字符沿用原有行为：连同反斜杠一起忽略
+                    break;
+            }
+        }
+    }
+
+    size_t unescapeInto(std::string_view raw, std::string &out) {
+        out.reserve(out.size() + raw.size());
+        return unescapeTo(raw, out, false);
+    }
+
+    /// 原地反转义 [data, data + size)，结果写回 data 开头并返回其长度；第一个无效转义的位置写入 error
+    size_t unescapeInPlace(char *data, size_t size, size_t &error) {
+        InPlaceOutput out{data, 0};
+        error = unescapeTo(std::string_view(data, size), out, true);
+        return out.size;
+    }
+
+    /// 以 std::to_chars 的最短可还原表示追加到 out 末尾；没有小数点与指数时补上 ".0"，
+    /// 重新解析后仍是浮点数。JSON 无法表示的 NaN 与无穷大输出为 null
+    template<typename T>
+    void appendReal(T value, std::string &out) {
+        if (!std::isfinite(value)) {
+            out += "null";
+            return;
+        }
+        char buffer[32];
+        char *end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+        out.append(buffer, end);
+        if (std::find_if(buffer, end, [](char c) { return c == '.' || c == 'e'; }) == end) out += ".0";
+    }
+
+    void appendInteger(int64_t value, std::string &out) {
+        char buffer[24];
+        out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+    }
+
+    /// 转义 value 并追加到 out 末尾：不需要转义的片段整段复制；没有简写形式的控制字符写成 \u00XX
+    void escapeInto(std::string_view value, std::string &out) {
+        static constexpr char HEX[] = "0123456789abcdef";
+        size_t pos = 0;
+        while (true) {
+            size_t next = findEscape(value.data(), pos, value.size());
+            out.append(value.data() + pos, next - pos);
+            if (next == value.size()) return;
+            auto c = static_cast<unsigned char>(value[next]);
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\b': out += "\\b"; break;
+                case '\f': out += "\\f"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default: {
+                    const char unicode[] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF]};
+                    out.append(unicode, sizeof(unicode));
+                    break;
+                }
+            }
+            pos = next + 1;
+        }
+    }
+}
+
+namespace {
+    /// 进程内共享的工作线程池：run() 将任务 0..count-1 分发给工作线程，调用线程同样参与执行
+    class WorkerPool {
+    public:
+        static WorkerPool &instance() {
+            static WorkerPool pool;
+            return pool;
+        }
+
+        static size_t defaultThreads() {
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        /// 最多使用 threads 个线程（含调用线程）执行 task，全部完成后返回；任务抛出的第一个异常会在此重新抛出
+        void run(size_t count, size_t threads, const std::function<void(size_t)> &task) {
+            size_t helpers = std::min(threads, count);
+            if (helpers <= 1) {
+                for (size_t i = 0; i < count; ++i) task(i);
+                return;
+            }
+            Job job{task, count, helpers - 1};
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                /// 线程数按需增长，之后保留以供复用
+                while (_workers.size() < helpers - 1) {
+                    _workers.emplace_back([this] { loop(); });
+                }
+                _jobs.push_back(&job);
+            }
+            _wake.notify_all();
+            work(job);
+            std::unique_lock<std::mutex> lock(_mutex);
+            _jobs.erase(std::find(_jobs.begin(), _jobs.end(), &job));
+            _finished.wait(lock, [&job] { return job.active == 0; });
+            if (job.error) std::rethrow_exception(job.error);
+        }
+
+    private:
+        struct Job {
+            Job(const std::function<void(size_t)> &task, size_t count, size_t helpers)
+                : task(task), count(count), helpers(helpers) {}
+
+            const std::function<void(size_t)> &task;
+            size_t count;
+            size_t helpers;
+            std::atomic<size_t> next{0};
+            size_t active{0};
+            std::exception_ptr error;
+        };
+
+        WorkerPool() = default;
+
+        ~WorkerPool() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _wake.notify_all();
+            for (auto &worker : _workers) worker.join();
+        }
+
+        void work(Job &job) {
+            for (size_t i = job.next++; i < job.count; i = job.next++) {
+                try {
+                    job.task(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (!job.error) job.error = std::current_exception();
+                    job.next = job.count;
+                }
+            }
+        }
+
+        void loop() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (true) {
+                Job *job = nullptr;
+                _wake.wait(lock, [this, &job] {
+                    for (Job *waiting : _jobs) {
+                        if (waiting->helpers > 0) {
+                            job = waiting;
+                            break;
+                        }
+                    }
+                    return _stop || job;
+                });
+                if (_stop) return;
+                job->helpers--;
+                job->active++;
+                lock.unlock();
+                work(*job);
+                lock.lock();
+                if (--job->active == 0) _finished.notify_all();
+            }
+        }
+
+        std::vector<std::thread> _workers;
+        std::vector<Job *> _jobs;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::condition_variable _finished;
+        bool _stop{false};
+    };
+}
+
+namespace {
+    /// 大数组并行解析的切分扫描：统计 [begin, end) 内未转义引号数的奇偶性，
+    /// 以及假设起点位于字符串外（depth[0]）/ 内（depth[1]）时的括号深度变化
+    struct SplitScan {
+        bool quote_parity;
+        int64_t depth[2];
+    };
+
+    bool escapedAt(std::string_view json, size_t pos) {
+        size_t run = pos;
+        while (run > 0 && json[run - 1] == '\\') run--;
+        return (pos - run) % 2 == 1;
+    }
+
+    SplitScan scanSplit(std::string_view json, size_t begin, size_t end) {
+        SplitScan scan{false, {0, 0}};
+        bool escaped = escapedAt(json, begin);
+        for (size_t i = begin; i < end; ++i) {
+            char c = json[i];
+            if (escaped) {
+                escaped = false;
+            } else if (c == '\\') {
+                escaped = true;
+            } else if (c == '"') {
+                scan.quote_parity = !scan.quote_parity;
+            } else if (c == '{' || c == '[') {
+                scan.depth[scan.quote_parity]++;
+            } else if (c == '}' || c == ']') {
+                scan.depth[scan.quote_parity]--;
+            }
+        }
+        return scan;
+    }
+
+    /// 已知起点状态时，查找 [begin, end) 内第一个位于顶层数组中的逗号
+    size_t findSeparator(std::string_view json, size_t begin, size_t end, bool in_string, int64_t depth) {
+        bool escaped = escapedAt(json, begin);
+        for (size_t i = begin; i < end; ++i) {
+            char c = json[i];
+            if (escaped) {
+                escaped = false;
+            } else if (c == '\\') {
+                escaped = true;
+            } else if (c == '"') {
+                in_string = !in_string;
+            } else if (in_string) {
+                continue;
+            } else if (c == '{' || c == '[') {
+                depth++;
+            } else if (c == '}' || c == ']') {
+                depth--;
+            } else if (c == ',' && depth == 1) {
+                return i;
+            }
+        }
+        return std::string_view::npos;
+    }
+}
+
+namespace {
+    /// 只读映射整个文件，直接在映射的字节上解析；无法映射时（如管道、空文件）一次性读入内存
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string &file_name) {
+#if defined(_WIN32)
+            _file = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (_file == INVALID_HANDLE_VALUE) return;
+            _open = true;
+            LARGE_INTEGER size{};
+            if (GetFileSizeEx(_file, &size) && size.QuadPart > 0) {
+                _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (_mapping) {
+                    void *data = MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+                    if (data) {
+                        _data = data;
+                        _view = {static_cast<const char *>(data), static_cast<size_t>(size.QuadPart)};
+                        return;
+                    }
+                }
+                _buffer.reserve(static_cast<size_t>(size.QuadPart));
+            }
+            char chunk[65536];
+            DWORD read = 0;
+            while (ReadFile(_file, chunk, sizeof(chunk), &read, nullptr) && read > 0) {
+                _buffer.append(chunk, read);
+            }
+#elif defined(JSONBUILDER_POSIX_FILE)
+            int fd = ::open(file_name.c_str(), O_RDONLY);
+            if (fd < 0) return;
+            _open = true;
+            struct stat info{};
+            if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+                auto size = static_cast<size_t>(info.st_size);
+                void *data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data != MAP_FAILED) {
+                    ::madvise(data, size, MADV_SEQUENTIAL);
+                    ::close(fd);
+                    _data = data;
+                    _view = {static_cast<const char *>(data), size};
+                    return;
+                }
+                _buffer.reserve(size);
+            }
+            char chunk[65536];
+            ssize_t read;
+            while ((read = ::read(fd, chunk, sizeof(chunk))) > 0) {
+                _buffer.append(chunk, static_cast<size_t>(read));
+            }
+            ::close(fd);
+#else
+            std::ifstream file(file_name, std::ios::in | std::ios::binary);
+            if (!file.is_open()) return;
+            _open = true;
+            _buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+#endif
+            _view = _buffer;
+        }
+
+        ~MappedFile() {
+#if defined(_WIN32)
+            if (_data) UnmapViewOfFile(_data);
+            if (_mapping) CloseHandle(_mapping);
+            if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+#elif defined(JSONBUILDER_POSIX_FILE)
+            if (_data) ::munmap(_data, _view.size());
+#endif
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        [[nodiscard]] bool isOpen() const { return _open; }
+        [[nodiscard]] std::string_view view() const { return _view; }
+
+    private:
+#if defined(_WIN32)
+        HANDLE _file{INVALID_HANDLE_VALUE};
+        HANDLE _mapping{nullptr};
+#endif
+        void *_data{nullptr};
+        std::string _buffer;
+        std::string_view _view;
+        bool _open{false};
+    };
+}
+
+namespace {
+    /// 数字解析：按 JSON 语法扫描并转换，不复制文本、不分配内存
+    enum class NumberError : uint8_t {
+        None,
+        LeadingZero,
+        RepeatedMinus,
+        RepeatedPoint,
+        Invalid
+    };
+
+    struct Number {
+        size_t length{0};
+        NumberError error{NumberError::None};
+        size_t error_at{0};
+        bool is_integer{true};
+        int64_t integer{0};
+        double real{0};
+    };
+
+    bool isNumberChar(char c) {
+        return (c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-';
+    }
+
+    /// 从 text 起始处解析一个数字；整数超出 int64 范围时转为 double
+    Number parseNumberText(std::string_view text) {
+        /// 尾数不超过 2^53 且十进制指数在 ±22 以内时，一次乘除即可得到精确结果
+        static constexpr double POW10[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        Number number;
+        size_t pos = 0, size = text.size();
+        auto digit = [&text, size](size_t i) {
+            return i < size && text[i] >= '0' && text[i] <= '9';
+        };
+        auto fail = [&number](NumberError error, size_t at) {
+            number.error = error;
+            number.error_at = at;
+            return number;
+        };
+        bool negative = (size > 0 && text[0] == '-');
+        if (negative) pos++;
+        if (pos < size && text[pos] == '-') return fail(NumberError::RepeatedMinus, pos);
+        if (!digit(pos)) return fail(NumberError::Invalid, 0);
+        if (text[pos] == '0' && digit(pos + 1)) return fail(NumberError::LeadingZero, pos);
+
+        uint64_t mantissa = 0;
+        int digits = 0;
+        int64_t exponent = 0;
+        bool truncated = false;
+        auto accumulate = [&](char c, bool fraction) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(c - '0');
+                if (mantissa) digits++;
+                if (fraction) exponent--;
+            } else {
+                truncated = true;
+                if (!fraction) exponent++;
+            }
+        };
+        size_t int_begin = pos;
+        for (; digit(pos); ++pos) accumulate(text[pos], false);
+        size_t int_digits = pos - int_begin;
+        bool point = false;
+        if (pos < size && text[pos] == '.') {
+            point = true;
+            number.is_integer = false;
+            if (++pos < size && text[pos] == '.') return fail(NumberError::RepeatedPoint, pos);
+            if (!digit(pos)) return fail(NumberError::Invalid, 0);
+            for (; digit(pos); ++pos) accumulate(text[pos], true);
+        }
+        if (pos < size && (text[pos] == 'e' || text[pos] == 'E')) {
+            number.is_integer = false;
+            bool exp_negative = false;
+            if (++pos < size && (text[pos] == '+' || text[pos] == '-')) exp_negative = (text[pos++] == '-');
+            if (!digit(pos)) return fail(NumberError::Invalid, 0);
+            int64_t value = 0;
+            for (; digit(pos); ++pos) {
+                if (value < 100000) value = value * 10 + (text[pos] - '0');
+            }
+            exponent += exp_negative ? -value : value;
+        }
+        if (pos < size && isNumberChar(text[pos])) {
+            if (text[pos] == '.' && point) return fail(NumberError::RepeatedPoint, pos);
+            if (text[pos] == '-' && negative) return fail(NumberError::RepeatedMinus, pos);
+            return fail(NumberError::Invalid, 0);
+        }
+        number.length = pos;
+
+        if (number.is_integer) {
+            if (int_digits <= 18) {
+                number.integer = negative ? -static_cast<int64_t>(mantissa) : static_cast<int64_t>(mantissa);
+                return number;
+            }
+            auto result = std::from_chars(text.data(), text.data() + pos, number.integer);
+            if (result.ec == std::errc()) return number;
+            number.is_integer = false;
+        }
+        if (!truncated && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+            double value = static_cast<double>(mantissa);
+            value = (exponent < 0) ? value / POW10[-exponent] : value * POW10[exponent];
+            number.real = negative ? -value : value;
+            return number;
+        }
+        auto result = std::from_chars(text.data(), text.data() + pos, number.real);
+        if (result.ec == std::errc::result_out_of_range) {
+            /// 下溢取 0，上溢视为无法解析
+            if (exponent >= 0) return fail(NumberError::Invalid, 0);
+            number.real = negative ? -0.0 : 0.0;
+        }
+        return number;
+    }
+
+    /// 整数按数值选择 int32 或 int64 存储
+    Json::JValue narrowInteger(int64_t value) {
+        if (value >= std::numeric_limits<int32_t>::min() && value <= std::numeric_limits<int32_t>::max()) {
+            return static_cast<int32_t>(value);
+        }
+        return value;
+    }
+
+    /// 错误信息（不含位置）
+    std::string numberError(const Number &number, std::string_view text) {
+        switch (number.error) {
+            case NumberError::LeadingZero:
+                return "The number can not start with the digit '0'";
+            case NumberError::RepeatedMinus:
+                return "The number is not allowed to have repeated '-' characters";
+            case NumberError::RepeatedPoint:
+                return "The number is not allowed to have repeated '.' characters";
+            default: {
+                size_t length = 0;
+                while (length < text.size() && isNumberChar(text[length])) length++;
+                return "Can't parse number '" + std::string(text.substr(0, length)) + "'";
+            }
+        }
+    }
+}
+
+template<typename T>
+Json::Internal::SharedVector<T>::SharedVector(const SharedVector &other) noexcept : _block(other._block) {
+    if (_block) _block->references.fetch_add(1, std::memory_order_relaxed);
+}
+
+template<typename T>
+Json::Internal::SharedVector<T>::SharedVector(SharedVector &&other) noexcept
+    : _block(std::exchange(other._block, nullptr)) {}
+
+template<typename T>
+Json::Internal::SharedVector<T> &Json::Internal::SharedVector<T>::operator=(SharedVector other) noexcept {
+    std::swap(_block, other._block);
+    return *this;
+}
+
+template<typename T>
+Json::Internal::SharedVector<T>::~SharedVector() {
+    release(_block);
+}
+
+template<typename T>
+const T &Json::Internal::SharedVector<T>::at(size_t index) const {
+    if (index >= size()) throw std::out_of_range("SharedVector::at");
+    return data()[index];
+}
+
+template<typename T>
+T *Json::Internal::SharedVector<T>::begin() {
+    detach();
+    return data();
+}
+
+template<typename T>
+T *Json::Internal::SharedVector<T>::end() {
+    detach();
+    return data() + size();
+}
+
+template<typename T>
+T &Json::Internal::SharedVector<T>::operator[](size_t index) {
+    detach();
+    return data()[index];
+}
+
+template<typename T>
+T &Json::Internal::SharedVector<T>::at(size_t index) {
+    if (index >= size()) throw std::out_of_range("SharedVector::at");
+    detach();
+    return data()[index];
+}
+
+template<typename T>
+T &Json::Internal::SharedVector<T>::back() {
+    detach();
+    return data()[size() - 1];
+}
+
+template<typename T>
+void Json::Internal::SharedVector<T>::reserve(size_t capacity) {
+    if (!_block || capacity > _block->capacity)
+        reallocate(capacity);
+    else
+        detach();
+}
+
+template<typename T>
+void Json::Internal::SharedVector<T>::assign(size_t count, const T &value) {
+    clear();
+    if (count == 0) return;
+    reallocate(count);
+    std::uninitialized_fill_n(data(), count, value);
+    _block->size = count;
+}
+
+template<typename T>
+T &Json::Internal::SharedVector<T>::push_back(T value) {
+    size_t count = size();
+    if (!_block || count == _block->capacity)
+        reallocate(std::max<size_t>(count * 2, 1));
+    else
+        detach();
+    T *slot = new (data() + count) T(std::move(value));
+    _block->size++;
+    return *slot;
+}
+
+template<typename T>
+T *Json::Internal::SharedVector<T>::insert(const T *position, T value) {
+    auto index = static_cast<size_t>(position - begin());
+    push_back(std::move(value));
+    T *values = data();
+    std::rotate(values + index, values + size() - 1, values + size());
+    return values + index;
+}
+
+template<typename T>
+T *Json::Internal::SharedVector<T>::erase(const T *position) {
+    auto index = static_cast<size_t>(position - begin());
+    T *values = data();
+    std::move(values + index + 1, values + size(), values + index);
+    pop_back();
+    return data() + index;
+}
+
+template<typename T>
+void Json::Internal::SharedVector<T>::pop_back() {
+    detach();
+    data()[size() - 1].~T();
+    _block->size--;
+}
+
+template<typename T>
+void Json::Internal::SharedVector<T>::clear() noexcept {
+    release(std::exchange(_block, nullptr));
+}
+
+/// 引用计数为 1 时本副本独占内存块：acquire 读取与其他副本析构时的 acq_rel 递减同步，
+/// 保证它们对元素的读取都先于此后的修改
+template<typename T>
+void Json::Internal::SharedVector<T>::detach() {
+    if (_block && _block->references.load(std::memory_order_acquire) != 1)
+        reallocate(_block->capacity);
+}
+
+template<typename T>
+void Json::Internal::SharedVector<T>::reallocate(size_t capacity) {
+    static_assert(alignof(T) <= alignof(Block) && sizeof(Block) % alignof(T) == 0);
+    static_assert(std::is_nothrow_move_constructible_v<T>);
+    auto *block = static_cast<Block *>(::operator new(sizeof(Block) + capacity * sizeof(T)));
+    new (block) Block{1, 0, capacity};
+    auto *target = reinterpret_cast<T *>(block + 1);
+    size_t count = size();
+    if (!_block) {
+        _block = block;
+    } else if (_block->references.load(std::memory_order_acquire) == 1) {
+        T *source = data();
+        for (size_t i = 0; i < count; ++i) {
+            new (target + i) T(std::move(source[i]));
+            source[i].~T();
+        }
+        ::operator delete(std::exchange(_block, block));
+    } else {
+        try {
+            std::uninitialized_copy_n(data(), count, target);
+        } catch (...) {
+            ::operator delete(block);
+            throw;
+        }
+        release(std::exchange(_block, block));
+    }
+    _block->size = count;
+}
+
+template<typename T>
+void Json::Internal::SharedVector<T>::release(Block *block) noexcept {
+    if (!block || block->references.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    auto *values = reinterpret_cast<T *>(block + 1);
+    for (size_t i = 0; i < block->size; ++i) values[i].~T();
+    ::operator delete(block);
+}
+
+template class Json::Internal::SharedVector<Json::JValue>;
+template class Json::Internal::SharedVector<std::pair<std::string, Json::JValue>>;
+template class Json::Internal::SharedVector<uint32_t>;
+
+namespace {
+    /// use_count() 只是 relaxed 读取：看到 1 时补一个 acquire 栅栏，与其他线程释放最后一个副本时的 acq_rel 递减同步，
+    /// 保证那些线程对子节点的读取先于此后通过可修改引用进行的写入
+    template<typename T>
+    bool isShared(const std::shared_ptr<T> &child) {
+        if (child.use_count() > 1) return true;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return false;
+    }
+
+    /// 通过可修改的引用交出子节点前调用：子节点还被其他容器（如快照）持有时换成它的副本，
+    /// 副本与原节点共享存储，直到某一方被修改，因此修改只会沿着路径逐层复制
+    void detachChild(Json::JValue &value) {
+        if (auto array = std::get_if<std::shared_ptr<Json::JArray>>(&value)) {
+            if (*array && isShared(*array)) *array = std::make_shared<Json::JArray>(**array);
+        } else if (auto object = std::get_if<std::shared_ptr<Json::JObject>>(&value)) {
+            if (*object && isShared(*object)) *object = std::make_shared<Json::JObject>(**object);
+        }
+    }
+}
 
 Json::JObject::JObject() = default;
 
-Json::JObject::constIterator Json::JObject::begin() const {
-    return _dict.begin();
-}
+bool Json::JObject::Storage::contains(std::string_view key) const {
+    return position(key) != std::string_view::npos;
+}
+
+const Json::JValue *Json::JObject::Storage::find(std::string_view key) const {
+    size_t found = position(key);
+    return found == std::string_view::npos ? nullptr : &_entries[found].second;
+}
+
+Json::JValue *Json::JObject::Storage::find(std::string_view key) {
+    size_t found = position(key);
+    return found == std::string_view::npos ? nullptr : &_entries[found].second;
+}
+
+Json::JValue &Json::JObject::Storage::operator[](std::string_view key) {
+    size_t found = position(key);
+    if (found != std::string_view::npos) return _entries[found].second;
+    return append(std::string(key), std::monostate{});
+}
+
+Json::JValue &Json::JObject::Storage::insert_or_assign(std::string key, Json::JValue value) {
+    size_t found = position(key);
+    if (found == std::string_view::npos) return append(std::move(key), std::move(value));
+    _entries[found].second = std::move(value);
+    return _entries[found].second;
+}
+
+void Json::JObject::Storage::assign(std::string_view key, Json::JValue value) {
+    size_t found = position(key);
+    if (found != std::string_view::npos)
+        _entries[found].second = std::move(value);
+    else
+        append(std::string(key), std::move(value));
+}
+
+/// 删除后保持其余键的顺序，索引整体重建
+size_t Json::JObject::Storage::erase(std::string_view key) {
+    size_t found = position(key);
+    if (found == std::string_view::npos) return 0;
+    _entries.erase(_entries.begin() + static_cast<ptrdiff_t>(found));
+    rebuildIndex();
+    return 1;
+}
+
+void Json::JObject::Storage::reserve(size_t capacity) {
+    _entries.reserve(capacity);
+}
+
+void Json::JObject::Storage::clear() {
+    _entries.clear();
+    _index.clear();
+}
+
+size_t Json::JObject::Storage::position(std::string_view key) const {
+    if (_index.empty()) {
+        for (size_t i = 0; i < _entries.size(); ++i) {
+            if (_entries[i].first == key) return i;
+        }
+        return std::string_view::npos;
+    }
+    size_t mask = _index.size() - 1;
+    for (size_t slot = std::hash<std::string_view>{}(key) & mask;; slot = (slot + 1) & mask) {
+        uint32_t i = _index[slot];
+        if (i == EMPTY_SLOT) return std::string_view::npos;
+        if (_entries[i].first == key) return i;
+    }
+}
+
+Json::JValue &Json::JObject::Storage::append(std::string &&key, Json::JValue &&value) {
+    JValue &result = _entries.push_back({std::move(key), std::move(value)}).second;
+    if (_entries.size() > INDEX_THRESHOLD) {
+        /// 负载因子不超过 1/2
+        if (_entries.size() * 2 > _index.size())
+            rebuildIndex();
+        else
+            addToIndex(_entries.size() - 1);
+    }
+    return result;
+}
+
+void Json::JObject::Storage::addToIndex(size_t position) {
+    size_t mask = _index.size() - 1;
+    size_t slot = std::hash<std::string_view>{}(std::as_const(_entries)[position].first) & mask;
+    uint32_t *index = _index.begin();
+    while (index[slot] != EMPTY_SLOT) slot = (slot + 1) & mask;
+    index[slot] = static_cast<uint32_t>(position);
+}
+
+void Json::JObject::Storage::rebuildIndex() {
+    _index.clear();
+    if (_entries.size() <= INDEX_THRESHOLD) return;
+    _index.assign(std::bit_ceil(_entries.size() * 4), EMPTY_SLOT);
+    for (size_t i = 0; i < _entries.size(); ++i) addToIndex(i);
+}
+
+
+const Json::JObject::Storage &Json::JObject::read() const {
+    return _dict;
+}
+
+/// Storage 的非 const 成员在存储被其他副本共享时先复制一份（只复制这一层，子节点仍然共享）
+Json::JObject::Storage &Json::JObject::write() {
+    return _dict;
+}
+
+Json::JObject::constIterator Json::JObject::begin() const {
+    return read().begin();
+}
+
+Json::JObject::constIterator Json::JObject::end() const {
+    return read().end();
+}
+
+Json::JObject::iterator Json::JObject::begin() {
+    Storage &storage = write();
+    for (auto entry : storage) detachChild(entry.second);
+    return storage.begin();
+}
+
+Json::JObject::iterator Json::JObject::end() {
+    return write().end();
+}
+
+size_t Json::JObject::size() const {
+    return _dict.size();
+}
+
+void Json::JObject::set(std::string_view key, const Json::JValue &value) {
+    write().assign(key, value);
+}
+
+void Json::JObject::set(std::string_view key, const Json::JArray &array) {
+    write().assign(key, std::make_shared<JArray>(array));
+}
+
+void Json::JObject::set(std::string_view key, const Json::JObject &object) {
+    write().assign(key, std::make_shared<JObject>(object));
+}
+
+void Json::JObject::set(std::string_view key, Json::JValue &&value) {
+    write().assign(key, std::move(value));
+}
+
+void Json::JObject::set(std::string_view key, Json::JArray &&array) {
+    write().assign(key, std::make_shared<JArray>(std::move(array)));
+}
+
+void Json::JObject::set(std::string_view key, Json::JObject &&object) {
+    write().assign(key, std::make_shared<JObject>(std::move(object)));
+}
+
+Json::JArray &Json::JObject::emplaceArray(std::string_view key) {
+    auto array = std::make_shared<JArray>();
+    JArray &result = *array;
+    write().assign(key, std::move(array));
+    return result;
+}
+
+Json::JObject &Json::JObject::emplaceObject(std::string_view key) {
+    auto object = std::make_shared<JObject>();
+    JObject &result = *object;
+    write().assign(key, std::move(object));
+    return result;
+}
+
+Json::JValue & Json::JObject::get(std::string_view key) {
+    if (JValue *value = write().find(key)) {
+        detachChild(*value);
+        return *value;
+    }
+    throw JException::KeyIsNotFoundException("The key '" + std::string(key) + "' is not found in object!");
+}
+
+bool Json::JObject::valid(std::string_view key) const {
+    return read().contains(key);
+}
+
+void Json::JObject::remove(std::string_view key) {
+    write().erase(key);
+}
+
+void Json::JObject::clear() {
+    _dict.clear();
+}
+
+const Json::JValue &Json::JObject::lookup(std::string_view key) const {
+    const JValue *value = read().find(key);
+    if (!value) {
+        throw JException::KeyIsNotFoundException("The key '" + std::string(key) + "' is not found in object!");
+    }
+    return *value;
+}
+
+bool Json::JObject::toBool(std::string_view key) const {
+    const JValue &value = lookup(key);
+    if (auto result = std::get_if<bool>(&value))
+        return *result;
+    throw JException::GetBadValueException("Can't get value from key '" + std::string(key) + "'!");
+}
+
+int32_t Json::JObject::toInt(std::string_view key) const {
+    const JValue &value = lookup(key);
+    if (auto result = std::get_if<int32_t>(&value))
+        return *result;
+    if (auto result = std::get_if<int64_t>(&value))
+        return static_cast<int32_t>(*result);
+    throw JException::GetBadValueException("Can't get value from key '" + std::string(key) + "'!");
+}
+
+int64_t Json::JObject::toBigInt(std::string_view key) const {
+    const JValue &value = lookup(key);
+    if (auto result = std::get_if<int64_t>(&value))
+        return *result;
+    if (auto result = std::get_if<int32_t>(&value))
+        return static_cast<int64_t>(*result);
+    throw JException::GetBadValueException("Can't get value from key '" + std::string(key) + "'!");
+}
+
+float Json::JObject::toFloat(std::string_view key) const {
+    const JValue &value = lookup(key);
+    if (auto result = std::get_if<float>(&value))
+        return *result;
+    if (auto result = std::get_if<double>(&value))
+        return static_cast<float>(*result);
+    throw JException::GetBadValueException("Can't get value from key '" + std::string(key) + "'!");
+}
+
+double Json::JObject::toDouble(std::string_view key) const {
+    const JValue &value = lookup(key);
+    if (auto result = std::get_if<double>(&value))
+        return *result;
+    throw JException::GetBadValueException("Can't get value from key '" + std::string(key) + "'!");
+}
+
+const std::string & Json::JObject::toString(std::string_view key) const {
+    const JValue &value = lookup(key);
+    if (auto result = std::get_if<std::string>(&value))
+        return *result;
+    throw JException::GetBadValueException("Can't get value from key '" + std::string(key) + "'!");
+}
+
+const Json::JArray* Json::JObject::toArray(std::string_view key) const {
+    const JValue &value = lookup(key);
+    if (auto result = std::get_if<std::shared_ptr<JArray>>(&value))
+        return result->get();
+    throw JException::GetBadValueException("Can't get value from key '" + std::string(key) + "'!");
+}
+
+const Json::JObject* Json::JObject::toObject(std::string_view key) const {
+    const JValue &value = lookup(key);
+    if (auto result = std::get_if<std::shared_ptr<JObject>>(&value))
+        return result->get();
+    throw JException::GetBadValueException("Can't get value from key '" + std::string(key) + "'!");
+}
+
+/// 不存在时默认创建并设定为空值
+Json::JValue &Json::JObject::operator[](std::string_view key) {
+    JValue &value = write()[key];
+    detachChild(value);
+    return value;
+}
+
+std::vector<std::string> Json::JObject::keys() const {
+    std::vector<std::string> _keys;
+    _keys.reserve(size());
+    for (auto& k : read()) {
+        _keys.emplace_back(k.first);
+    }
+    return _keys;
+}
+
+bool Json::JObject::isNull(std::string_view key) const {
+    return lookup(key).index() == JDataType::Null;
+}
+
+/// 紧凑存储的数值数组：real 为 false 时数据在 integers 中，否则在 doubles 中
+struct Json::JArray::Packed {
+    bool real{false};
+    std::vector<int64_t> integers;
+    std::vector<double> doubles;
+
+    [[nodiscard]] size_t size() const { return real ? doubles.size() : integers.size(); }
+
+    /// 展开为 JValue；整数按数值还原为 int32 或 int64，与解析得到的类型一致
+    [[nodiscard]] Internal::SharedVector<JValue> unpack() const {
+        Internal::SharedVector<JValue> values;
+        values.reserve(size());
+        if (real) {
+            for (double value : doubles) values.push_back(value);
+        } else {
+            for (int64_t value : integers) values.push_back(narrowInteger(value));
+        }
+        return values;
+    }
+
+    /// 供 JArray::get() 返回引用：第一次调用时展开一次并缓存，多个线程可以同时读取
+    [[nodiscard]] const Internal::SharedVector<JValue> &values() const {
+        std::call_once(_once, [this] { _values = unpack(); });
+        return _values;
+    }
+
+private:
+    mutable std::once_flag _once;
+    mutable Internal::SharedVector<JValue> _values;
+};
+
+Json::JArray::JArray() = default;
+
+Json::JArray::JArray(std::vector<JValue> &&values) {
+    _dict.reserve(values.size());
+    for (auto &value : values) _dict.push_back(std::move(value));
+}
+
+const Json::JValue *Json::JArray::element(size_t index) const {
+    if (!_packed) return &_dict.at(index);
+    if (index >= _packed->size()) throw std::out_of_range("JArray::element");
+    return nullptr;
+}
+
+/// 紧凑存储先展开为普通存储；_dict 被其他副本共享时由它的非 const 成员复制
+Json::Internal::SharedVector<Json::JValue> &Json::JArray::write() {
+    if (_packed) {
+        _dict = _packed->unpack();
+        _packed.reset();
+    }
+    return _dict;
+}
+
+/// 只保存当前元素，不缓存整个数组
+const Json::JValue &Json::JArray::constIterator::unpacked() const {
+    if (_integers)
+        _current = narrowInteger(_integers[_index]);
+    else
+        _current = _reals[_index];
+    return _current;
+}
+
+Json::JArray::constIterator Json::JArray::begin() const {
+    constIterator it;
+    if (!_packed)
+        it._values = _dict.begin();
+    else if (_packed->real)
+        it._reals = _packed->doubles.data();
+    else
+        it._integers = _packed->integers.data();
+    return it;
+}
+
+Json::JArray::constIterator Json::JArray::end() const {
+    constIterator it = begin();
+    it._index = size();
+    return it;
+}
+
+Json::JArray::iterator Json::JArray::begin() {
+    auto &values = write();
+    for (auto &value : values) detachChild(value);
+    return values.begin();
+}
+
+Json::JArray::iterator Json::JArray::end() {
+    return write().end();
+}
+
+size_t Json::JArray::size() const {
+    if (_packed) return _packed->size();
+    return _dict.size();
+}
+
+size_t Json::JArray::length() const {
+    return size();
+}
+
+const Json::JValue &Json::JArray::get(size_t index) const {
+    if (_packed) return _packed->values().at(index);
+    return _dict.at(index);
+}
+
+bool Json::JArray::isNull(size_t index) const {
+    const JValue *value = element(index);
+    return value && value->index() == JDataType::Null;
+}
+
+bool Json::JArray::toBool(size_t index) const {
+    const JValue *value = element(index);
+    if (value && std::holds_alternative<bool>(*value))
+        return std::get<bool>(*value);
+    else
+        throw JException::GetBadValueException("Can't get value from index '" + std::to_string(index) + "'!");
+}
+
+int32_t Json::JArray::toInt(size_t index) const {
+    if (_packed && !_packed->real)
+        return static_cast<int32_t>(_packed->integers.at(index));
+    const JValue *value = element(index);
+    if (value && std::holds_alternative<int32_t>(*value))
+        return std::get<int32_t>(*value);
+    else if (value && std::holds_alternative<int64_t>(*value))
+        return static_cast<int32_t>(std::get<int64_t>(*value));
+    else
+        throw JException::GetBadValueException("Can't get value from index '" + std::to_string(index) + "'!");
+}
+
+int64_t Json::JArray::toBigInt(size_t index) const {
+    if (_packed && !_packed->real)
+        return _packed->integers.at(index);
+    const JValue *value = element(index);
+    if (value && std::holds_alternative<int32_t>(*value))
+        return std::get<int32_t>(*value);
+    else if (value && std::holds_alternative<int64_t>(*value))
+        return std::get<int64_t>(*value);
+    else
+        throw JException::GetBadValueException("Can't get value from index '" + std::to_string(index) + "'!");
+}
+
+float Json::JArray::toFloat(size_t index) const {
+    if (_packed && _packed->real)
+        return static_cast<float>(_packed->doubles.at(index));
+    const JValue *value = element(index);
+    if (value && std::holds_alternative<float>(*value))
+        return std::get<float>(*value);
+    else if (value && std::holds_alternative<double>(*value))
+        return static_cast<float>(std::get<double>(*value));
+    else
+        throw JException::GetBadValueException("Can't get value from index '" + std::to_string(index) + "'!");
+}
+
+double Json::JArray::toDouble(size_t index) const {
+    if (_packed && _packed->real)
+        return _packed->doubles.at(index);
+    const JValue *value = element(index);
+    if (value && std::holds_alternative<float>(*value))
+        return static_cast<double>(std::get<float>(*value));
+    else if (value && std::holds_alternative<double>(*value))
+        return std::get<double>(*value);
+    else
+        throw JException::GetBadValueException("Can't get value from index '" + std::to_string(index) + "'!");
+}
+
+const std::string &Json::JArray::toString(size_t index) const {
+    const JValue *value = element(index);
+    if (value && std::holds_alternative<std::string>(*value))
+        return std::get<std::string>(*value);
+    else
+        throw JException::GetBadValueException("Can't get value from index '" + std::to_string(index) + "'!");
+}
+
+const Json::JArray *Json::JArray::toArray(size_t index) const {
+    const JValue *value = element(index);
+    if (value && std::holds_alternative<std::shared_ptr<JArray>>(*value))
+        return std::get<std::shared_ptr<JArray>>(*value).get();
+    else
+        throw JException::GetBadValueException("Can't get value from index '" + std::to_string(index) + "'!");
+}
+
+const Json::JObject *Json::JArray::toObject(size_t index) const {
+    const JValue *value = element(index);
+    if (value && std::holds_alternative<std::shared_ptr<JObject>>(*value))
+        return std::get<std::shared_ptr<JObject>>(*value).get();
+    else
+        throw JException::GetBadValueException("Can't get value from index '" + std::to_string(index) + "'!");
+}
+
+void Json::JArray::pushBack(const Json::JValue &value) {
+    write().push_back(value);
+}
+
+void Json::JArray::pushBack(const Json::JArray &array) {
+    write().push_back(std::make_shared<JArray>(array));
+}
+
+void Json::JArray::pushBack(const Json::JObject &object) {
+    write().push_back(std::make_shared<JObject>(object));
+}
+
+void Json::JArray::pushFront(const Json::JValue &value) {
+    auto &values = write();
+    values.insert(values.begin(), value);
+}
+
+void Json::JArray::pushFront(const Json::JArray &array) {
+    auto &values = write();
+    values.insert(values.begin(), std::make_shared<JArray>(array));
+}
+
+void Json::JArray::pushFront(const Json::JObject &object) {
+    auto &values = write();
+    values.insert(values.begin(), std::make_shared<JObject>(object));
+}
+
+void Json::JArray::append(const Json::JValue &value) {
+    write().push_back(value);
+}
+
+void Json::JArray::append(const Json::JArray &array) {
+    write().push_back(std::make_shared<JArray>(array));
+}
+
+void Json::JArray::append(const Json::JObject &object) {
+    write().push_back(std::make_shared<JObject>(object));
+}
+
+void Json::JArray::insert(size_t index, const Json::JValue &value) {
+    auto &values = write();
+    values.insert(values.begin() + index, value);
+}
+
+void Json::JArray::insert(size_t index, const Json::JArray &value) {
+    auto &values = write();
+    values.insert(values.begin() + index, std::make_shared<JArray>(value));
+}
+
+void Json::JArray::insert(size_t index, const Json::JObject &value) {
+    auto &values = write();
+    values.insert(values.begin() + index, std::make_shared<JObject>(value));
+}
+
+void Json::JArray::pushBack(Json::JValue &&value) {
+    write().push_back(std::move(value));
+}
+
+void Json::JArray::pushBack(Json::JArray &&array) {
+    write().push_back(std::make_shared<JArray>(std::move(array)));
+}
+
+void Json::JArray::pushBack(Json::JObject &&object) {
+    write().push_back(std::make_shared<JObject>(std::move(object)));
+}
+
+void Json::JArray::pushFront(Json::JValue &&value) {
+    auto &values = write();
+    values.insert(values.begin(), std::move(value));
+}
+
+void Json::JArray::pushFront(Json::JArray &&array) {
+    auto &values = write();
+    values.insert(values.begin(), std::make_shared<JArray>(std::move(array)));
+}
+
+void Json::JArray::pushFront(Json::JObject &&object) {
+    auto &values = write();
+    values.insert(values.begin(), std::make_shared<JObject>(std::move(object)));
+}
+
+void Json::JArray::append(Json::JValue &&value) {
+    write().push_back(std::move(value));
+}
+
+void Json::JArray::append(Json::JArray &&array) {
+    write().push_back(std::make_shared<JArray>(std::move(array)));
+}
+
+void Json::JArray::append(Json::JObject &&object) {
+    write().push_back(std::make_shared<JObject>(std::move(object)));
+}
+
+void Json::JArray::insert(size_t index, Json::JValue &&value) {
+    auto &values = write();
+    values.insert(values.begin() + index, std::move(value));
+}
+
+void Json::JArray::insert(size_t index, Json::JArray &&value) {
+    auto &values = write();
+    values.insert(values.begin() + index, std::make_shared<JArray>(std::move(value)));
+}
+
+void Json::JArray::insert(size_t index, Json::JObject &&value) {
+    auto &values = write();
+    values.insert(values.begin() + index, std::make_shared<JObject>(std::move(value)));
+}
+
+Json::JArray &Json::JArray::emplaceArray() {
+    auto array = std::make_shared<JArray>();
+    JArray &result = *array;
+    write().push_back(std::move(array));
+    return result;
+}
+
+Json::JObject &Json::JArray::emplaceObject() {
+    auto object = std::make_shared<JObject>();
+    JObject &result = *object;
+    write().push_back(std::move(object));
+    return result;
+}
+
+void Json::JArray::remove(size_t index) {
+    auto &values = write();
+    values.erase(values.begin() + index);
+}
+
+void Json::JArray::popFront() {
+    auto &values = write();
+    values.erase(values.begin());
+}
+
+void Json::JArray::popBack() {
+    write().pop_back();
+}
+
+void Json::JArray::clear() {
+    _dict.clear();
+    _packed.reset();
+}
+
+void Json::JArray::sort(const std::function<bool(JValue&, JValue&)> &sort_function) {
+    if (sort_function) {
+        std::sort(begin(), end(), sort_function);
+    }
+}
+
+Json::JArray& Json::JArray::operator<<(const Json::JValue &value) {
+    write().push_back(value);
+    return *this;
+}
+
+Json::JArray& Json::JArray::operator<<(const Json::JArray &array) {
+    write().push_back(std::make_shared<JArray>(array));
+    return *this;
+}
+
+Json::JArray& Json::JArray::operator<<(const Json::JObject &object) {
+    write().push_back(std::make_shared<JObject>(object));
+    return *this;
+}
+
+Json::JArray& Json::JArray::operator<<(Json::JValue &&value) {
+    write().push_back(std::move(value));
+    return *this;
+}
+
+Json::JArray& Json::JArray::operator<<(Json::JArray &&array) {
+    write().push_back(std::make_shared<JArray>(std::move(array)));
+    return *this;
+}
+
+Json::JArray& Json::JArray::operator<<(Json::JObject &&object) {
+    write().push_back(std::make_shared<JObject>(std::move(object)));
+    return *this;
+}
+
+Json::JValue& Json::JArray::operator[](size_t index) {
+    JValue &value = write().at(index);
+    detachChild(value);
+    return value;
+}
+
+std::span<const int64_t> Json::JArray::integers() const {
+    if (_packed && !_packed->real) return _packed->integers;
+    return {};
+}
+
+std::span<const double> Json::JArray::doubles() const {
+    if (_packed && _packed->real) return _packed->doubles;
+    return {};
+}
+
+bool Json::JArray::pack(std::span<const JValue> values) {
+    if (values.size() < PACK_THRESHOLD) return false;
+    size_t type = values.front().index();
+    if (type != JDataType::Int && type != JDataType::BigInt && type != JDataType::Double) return false;
+    auto packed = std::make_shared<Packed>();
+    if (type == JDataType::Double) {
+        packed->real = true;
+        packed->doubles.reserve(values.size());
+        for (const auto &value : values) {
+            const auto *real = std::get_if<double>(&value);
+            if (!real) return false;
+            packed->doubles.push_back(*real);
+        }
+    } else {
+        packed->integers.reserve(values.size());
+        for (const auto &value : values) {
+            if (const auto *small = std::get_if<int32_t>(&value))
+                packed->integers.push_back(*small);
+            else if (const auto *big = std::get_if<int64_t>(&value))
+                packed->integers.push_back(*big);
+            else
+                return false;
+        }
+    }
+    _packed = std::move(packed);
+    _dict.clear();
+    return true;
+}
+
+namespace {
+    struct Reduction {
+        size_t count;
+        double sum;
+        double min;
+        double max;
+    };
+
+    /// 紧凑存储时直接归约；否则先把数值按类型收集到临时数组中，使结果与紧凑存储时一致
+    Reduction reduceArray(const Json::JArray &array) {
+        std::span<const int64_t> integers = array.integers();
+        std::span<const double> reals = array.doubles();
+        std::vector<int64_t> integer_values;
+        std::vector<double> real_values;
+        if (integers.empty() && reals.empty()) {
+            size_t index = 0;
+            for (const auto &value : array) {
+                if (const auto *small = std::get_if<int32_t>(&value))
+                    integer_values.push_back(*small);
+                else if (const auto *big = std::get_if<int64_t>(&value))
+                    integer_values.push_back(*big);
+                else if (const auto *real32 = std::get_if<float>(&value))
+                    real_values.push_back(*real32);
+                else if (const auto *real = std::get_if<double>(&value))
+                    real_values.push_back(*real);
+                else
+                    throw Json::JException::GetBadValueException("Can't get value from index '" +
+                                                                 std::to_string(index) + "'!");
+                ++index;
+            }
+            integers = integer_values;
+            reals = real_values;
+        }
+        Reduction result{integers.size() + reals.size(), 0.0, std::numeric_limits<double>::infinity(),
+                         -std::numeric_limits<double>::infinity()};
+        if (!integers.empty()) {
+            IntegerSummary summary = reduceIntegers(integers);
+            result.sum = summary.sum.value();
+            result.min = static_cast<double>(summary.min);
+            result.max = static_cast<double>(summary.max);
+        }
+        if (!reals.empty()) {
+            RealSummary summary = reduceReals(reals);
+            result.sum += summary.sum;
+            result.min = std::min(result.min, summary.min);
+            result.max = std::max(result.max, summary.max);
+        }
+        return result;
+    }
+
+    Reduction reduceNonEmpty(const Json::JArray &array) {
+        Reduction result = reduceArray(array);
+        if (!result.count) throw Json::JException::GetBadValueException("Can't reduce an empty array!");
+        return result;
+    }
+}
+
+double Json::JArray::sum() const {
+    return reduceArray(*this).sum;
+}
+
+double Json::JArray::min() const {
+    return reduceNonEmpty(*this).min;
+}
+
+double Json::JArray::max() const {
+    return reduceNonEmpty(*this).max;
+}
+
+double Json::JArray::mean() const {
+    Reduction result = reduceNonEmpty(*this);
+    return result.sum / static_cast<double>(result.count);
+}
+
+static_assert(sizeof(Json::JNode) == 16, "JNode should stay 16 bytes");
+
+namespace {
+    /// 冻结对象的完美哈希索引（hash-and-displace）：键按哈希分桶，每个桶选定一个位移，
+    /// 使桶内所有键落到互不冲突的槽位；查找时只计算一次哈希、读取两个数组并比较一次键
+    struct FrozenIndex {
+        static constexpr uint32_t EMPTY = UINT32_MAX;
+
+        uint32_t buckets;
+        uint32_t slots;
+
+        /// 槽位负载不超过 0.8，平均每桶 4 个键
+        static FrozenIndex shape(size_t count) {
+            return {static_cast<uint32_t>((count + 3) / 4), static_cast<uint32_t>(std::bit_ceil(count + count / 4))};
+        }
+
+        [[nodiscard]] const uint32_t *displacements() const { return reinterpret_cast<const uint32_t *>(this + 1); }
+        [[nodiscard]] const uint32_t *members() const { return displacements() + buckets; }
+        uint32_t *displacements() { return reinterpret_cast<uint32_t *>(this + 1); }
+        uint32_t *members() { return displacements() + buckets; }
+
+        static uint64_t hash(std::string_view key) {
+            return std::hash<std::string_view>{}(key);
+        }
+
+        [[nodiscard]] uint32_t bucket(uint64_t hash) const {
+            return static_cast<uint32_t>(((hash >> 32) * buckets) >> 32);
+        }
+
+        [[nodiscard]] uint32_t slot(uint64_t hash, uint32_t displacement) const {
+            uint64_t x = hash + displacement * 0x9E3779B97F4A7C15ULL;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+            return static_cast<uint32_t>(x ^ (x >> 31)) & (slots - 1);
+        }
+    };
+}
+
+Json::JNode::JNode() noexcept = default;
+
+Json::JNode::JNode(bool value) noexcept : _type(Bool) {
+    _value.boolean = value;
+}
+
+Json::JNode::JNode(int32_t value) noexcept : _value{.integer = value}, _type(Int) {}
+
+Json::JNode::JNode(int64_t value) noexcept : _value{.integer = value}, _type(BigInt) {}
+
+Json::JNode::JNode(float value) noexcept : _type(Float) {
+    _value.real32 = value;
+}
+
+Json::JNode::JNode(double value) noexcept : _type(Double) {
+    _value.real = value;
+}
+
+Json::JNode::JNode(std::string_view value) : _type(String) {
+    if (value.size() > UINT32_MAX) throw std::length_error("The string is too long for JNode!");
+    _length = static_cast<uint32_t>(value.size());
+    _value.text = nullptr;
+    if (_length) {
+        _value.text = new char[_length];
+        std::memcpy(_value.text, value.data(), _length);
+    }
+}
+
+Json::JNode::JNode(const char *value) : JNode(std::string_view(value)) {}
+
+Json::JNode::JNode(const Json::JValue &value) {
+    switch (value.index()) {
+        case JDataType::Bool: *this = JNode(std::get<bool>(value)); break;
+        case JDataType::Int: *this = JNode(std::get<int32_t>(value)); break;
+        case JDataType::BigInt: *this = JNode(std::get<int64_t>(value)); break;
+        case JDataType::Float: *this = JNode(std::get<float>(value)); break;
+        case JDataType::Double: *this = JNode(std::get<double>(value)); break;
+        case JDataType::String: *this = JNode(std::string_view(std::get<std::string>(value))); break;
+        case JDataType::Array: *this = JNode(*std::get<std::shared_ptr<JArray>>(value)); break;
+        case JDataType::Object: *this = JNode(*std::get<std::shared_ptr<JObject>>(value)); break;
+        default: break;
+    }
+}
+
+Json::JNode::JNode(const Json::JObject &object) : _type(Object) {
+    _value.block = nullptr;
+    try {
+        reserve(object.size());
+        for (auto &[key, value] : object) {
+            new (memberData() + _value.block->size) Member{JNode(std::string_view(key)), JNode(value)};
+            _value.block->size++;
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+Json::JNode::JNode(const Json::JArray &array) : _type(Array) {
+    _value.block = nullptr;
+    try {
+        reserve(array.size());
+        for (auto &value : array) {
+            new (itemData() + _value.block->size) JNode(value);
+            _value.block->size++;
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+Json::JNode::JNode(const Json::JNode &other) : _length(other._length), _type(other._type) {
+    if (_type == String) {
+        _value.text = nullptr;
+        if (_length) {
+            _value.text = new char[_length];
+            std::memcpy(_value.text, other._value.text, _length);
+        }
+    } else if (_type == Array || _type == Object) {
+        _value.block = nullptr;
+        try {
+            reserve(other.size());
+            for (size_t i = 0; i < other.size(); ++i) {
+                if (_type == Array)
+                    new (itemData() + i) JNode(other.itemData()[i]);
+                else
+                    new (memberData() + i) Member(other.memberData()[i]);
+                _value.block->size++;
+            }
+        } catch (...) {
+            release();
+            throw;
+        }
+    } else {
+        _value = other._value;
+    }
+}
+
+Json::JNode::JNode(Json::JNode &&other) noexcept
+    : _value(other._value), _length(other._length), _type(other._type), _flags(other._flags) {
+    other._value.integer = 0;
+    other._length = 0;
+    other._type = Null;
+    other._flags = 0;
+}
+
+Json::JNode &Json::JNode::operator=(const Json::JNode &other) {
+    if (this != &other) *this = JNode(other);
+    return *this;
+}
+
+Json::JNode &Json::JNode::operator=(Json::JNode &&other) noexcept {
+    if (this != &other) {
+        release();
+        _value = other._value;
+        _length = other._length;
+        _type = other._type;
+        _flags = other._flags;
+        other._value.integer = 0;
+        other._length = 0;
+        other._type = Null;
+        other._flags = 0;
+    }
+    return *this;
+}
+
+Json::JNode::~JNode() {
+    release();
+}
+
+Json::JNode Json::JNode::array(size_t capacity) {
+    JNode node;
+    node._type = Array;
+    node._value.block = nullptr;
+    node.reserve(capacity);
+    return node;
+}
+
+Json::JNode Json::JNode::object(size_t capacity) {
+    JNode node;
+    node._type = Object;
+    node._value.block = nullptr;
+    node.reserve(capacity);
+    return node;
+}
+
+Json::JDataType Json::JNode::type() const {
+    return static_cast<JDataType>(_type);
+}
+
+size_t Json::JNode::size() const {
+    if (_type == String) return _length;
+    if ((_type == Array || _type == Object) && _value.block) return _value.block->size;
+    return 0;
+}
+
+std::span<const Json::JNode> Json::JNode::items() const {
+    if (_type != Array) return {};
+    return {itemData(), size()};
+}
+
+std::span<Json::JNode> Json::JNode::items() {
+    if (_type != Array) return {};
+    return {itemData(), size()};
+}
+
+std::span<const Json::JNode::Member> Json::JNode::members() const {
+    if (_type != Object) return {};
+    return {memberData(), size()};
+}
+
+std::span<Json::JNode::Member> Json::JNode::members() {
+    if (_type != Object) return {};
+    return {memberData(), size()};
+}
+
+const Json::JNode &Json::JNode::at(size_t index) const {
+    if (_type != Array || index >= size()) throw std::out_of_range("The index is out of range of JNode!");
+    return itemData()[index];
+}
+
+Json::JNode &Json::JNode::at(size_t index) {
+    if (_type != Array || index >= size()) throw std::out_of_range("The index is out of range of JNode!");
+    return itemData()[index];
+}
+
+const Json::JNode *Json::JNode::find(std::string_view key) const {
+    if (_flags & Indexed) {
+        const Member *member = findIndexed(key);
+        return member ? &member->value : nullptr;
+    }
+    for (auto &member : members()) {
+        if (member.key.text() == key) return &member.value;
+    }
+    return nullptr;
+}
+
+Json::JNode *Json::JNode::find(std::string_view key) {
+    if (_flags & Indexed) {
+        const Member *member = findIndexed(key);
+        return member ? const_cast<JNode *>(&member->value) : nullptr;
+    }
+    for (auto &member : members()) {
+        if (member.key.text() == key) return &member.value;
+    }
+    return nullptr;
+}
+
+const Json::JNode &Json::JNode::get(std::string_view key) const {
+    if (auto value = find(key)) return *value;
+    throw JException::KeyIsNotFoundException("The key '" + std::string(key) + "' is not found in object!");
+}
+
+void Json::JNode::pushBack(Json::JNode value) {
+    if (_type != Array) throw JException::GetBadValueException("The specified value is not an array!");
+    if (size() == (_value.block ? _value.block->capacity : 0)) reserve(std::max<size_t>(4, size() * 2));
+    new (itemData() + _value.block->size) JNode(std::move(value));
+    _value.block->size++;
+}
+
+void Json::JNode::set(std::string_view key, Json::JNode value) {
+    if (_type != Object) throw JException::GetBadValueException("The specified value is not an object!");
+    if (auto existing = find(key)) {
+        *existing = std::move(value);
+        return;
+    }
+    if (size() == (_value.block ? _value.block->capacity : 0)) reserve(std::max<size_t>(4, size() * 2));
+    new (memberData() + _value.block->size) Member{JNode(key), std::move(value)};
+    _value.block->size++;
+}
+
+Json::JValue Json::JNode::toValue() const {
+    switch (_type) {
+        case Bool: return _value.boolean;
+        case Int: return static_cast<int32_t>(_value.integer);
+        case BigInt: return _value.integer;
+        case Float: return _value.real32;
+        case Double: return _value.real;
+        case String: return std::string(text());
+        case Array: {
+            auto array = std::make_shared<JArray>();
+            auto &values = array->write();
+            values.reserve(size());
+            for (auto &item : items()) values.push_back(item.toValue());
+            return array;
+        }
+        case Object: {
+            auto object = std::make_shared<JObject>();
+            auto &storage = object->write();
+            storage.reserve(size());
+            for (auto &member : members()) storage.insert_or_assign(std::string(member.key.text()),
+                                                                    member.value.toValue());
+            return object;
+        }
+        default: return std::monostate{};
+    }
+}
+
+Json::JNode::Block *Json::JNode::allocate(size_t capacity, size_t element_size,
+                                          std::pmr::memory_resource *resource, size_t extra) {
+    if (capacity > UINT32_MAX) throw std::length_error("The container is too large for JNode!");
+    size_t bytes = sizeof(Block) + capacity * element_size + extra;
+    auto block = static_cast<Block *>(resource ? resource->allocate(bytes, alignof(JNode)) : ::operator new(bytes));
+    block->size = 0;
+    block->capacity = static_cast<uint32_t>(capacity);
+    return block;
+}
+
+Json::JNode Json::JNode::text(std::string_view value, std::pmr::memory_resource *resource) {
+    if (!resource) return JNode(value);
+    if (value.size() > UINT32_MAX) throw std::length_error("The string is too long for JNode!");
+    JNode node;
+    node._type = String;
+    node._flags = External;
+    node._length = static_cast<uint32_t>(value.size());
+    node._value.text = nullptr;
+    if (node._length) {
+        node._value.text = static_cast<char *>(resource->allocate(node._length, 1));
+        std::memcpy(node._value.text, value.data(), node._length);
+    }
+    return node;
+}
+
+Json::JNode Json::JNode::borrow(std::string_view value) {
+    if (value.size() > UINT32_MAX) throw std::length_error("The string is too long for JNode!");
+    JNode node;
+    node._type = String;
+    node._flags = External;
+    node._length = static_cast<uint32_t>(value.size());
+    node._value.text = const_cast<char *>(value.data());
+    return node;
+}
+
+Json::JNode Json::JNode::container(Json::JDataType type, size_t capacity, std::pmr::memory_resource *resource) {
+    JNode node;
+    node._type = type;
+    node._flags = resource ? External : 0;
+    node._value.block = nullptr;
+    if (capacity) node._value.block = allocate(capacity, type == Array ? sizeof(JNode) : sizeof(Member), resource);
+    return node;
+}
+
+Json::JNode Json::JNode::frozen(const Json::JValue &value, std::pmr::memory_resource *resource) {
+    switch (value.index()) {
+        case JDataType::String: return text(std::get<std::string>(value), resource);
+        case JDataType::Array: return frozen(*std::get<std::shared_ptr<JArray>>(value), resource);
+        case JDataType::Object: return frozen(*std::get<std::shared_ptr<JObject>>(value), resource);
+        default: return JNode(value);
+    }
+}
+
+Json::JNode Json::JNode::frozen(const Json::JArray &array, std::pmr::memory_resource *resource) {
+    JNode node = container(Array, array.size(), resource);
+    for (auto &value : array) {
+        new (node.itemData() + node._value.block->size) JNode(frozen(value, resource));
+        node._value.block->size++;
+    }
+    return node;
+}
+
+/// 索引紧跟在成员之后：FrozenIndex 头、每个桶的位移、每个槽位对应的成员下标
+Json::JNode Json::JNode::frozen(const Json::JObject &object, std::pmr::memory_resource *resource) {
+    size_t count = object.size();
+    size_t extra = 0;
+    if (count > FROZEN_LINEAR) {
+        FrozenIndex shape = FrozenIndex::shape(count);
+        extra = sizeof(FrozenIndex) + (shape.buckets + shape.slots) * sizeof(uint32_t);
+    }
+    JNode node;
+    node._type = Object;
+    node._flags = External;
+    node._value.block = count ? allocate(count, sizeof(Member), resource, extra) : nullptr;
+    for (auto &[key, value] : object) {
+        new (node.memberData() + node._value.block->size) Member{text(key, resource), frozen(value, resource)};
+        node._value.block->size++;
+    }
+    if (count > FROZEN_LINEAR) node.buildIndex();
+    return node;
+}
+
+/// 桶按大小降序依次放置；极少数情况下找不到位移时退回顺序查找
+void Json::JNode::buildIndex() {
+    size_t count = size();
+    auto index = new (memberData() + _value.block->capacity) FrozenIndex(FrozenIndex::shape(count));
+    uint32_t *displacements = index->displacements();
+    uint32_t *slots = index->members();
+    std::fill(slots, slots + index->slots, FrozenIndex::EMPTY);
+
+    std::vector<uint64_t> hashes(count);
+    std::vector<std::vector<uint32_t>> buckets(index->buckets);
+    for (uint32_t i = 0; i < count; ++i) {
+        hashes[i] = FrozenIndex::hash(memberData()[i].key.text());
+        buckets[index->bucket(hashes[i])].push_back(i);
+    }
+    std::vector<uint32_t> order(index->buckets);
+    for (uint32_t i = 0; i < index->buckets; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return buckets[a].size() != buckets[b].size() ? buckets[a].size() > buckets[b].size() : a < b;
+    });
+
+    constexpr uint32_t MAX_DISPLACEMENT = 1u << 20;
+    std::vector<uint32_t> chosen;
+    for (uint32_t bucket : order) {
+        displacements[bucket] = 0;
+        if (buckets[bucket].empty()) continue;
+        uint32_t displacement = 0;
+        for (; displacement < MAX_DISPLACEMENT; ++displacement) {
+            chosen.clear();
+            for (uint32_t member : buckets[bucket]) {
+                uint32_t slot = index->slot(hashes[member], displacement);
+                if (slots[slot] != FrozenIndex::EMPTY ||
+                    std::find(chosen.begin(), chosen.end(), slot) != chosen.end())
+                    break;
+                chosen.push_back(slot);
+            }
+            if (chosen.size() == buckets[bucket].size()) break;
+        }
+        if (displacement == MAX_DISPLACEMENT) return;
+        displacements[bucket] = displacement;
+        for (size_t i = 0; i < chosen.size(); ++i) slots[chosen[i]] = buckets[bucket][i];
+    }
+    _flags |= Indexed;
+}
+
+const Json::JNode::Member *Json::JNode::findIndexed(std::string_view key) const {
+    auto index = reinterpret_cast<const FrozenIndex *>(memberData() + _value.block->capacity);
+    uint64_t hash = FrozenIndex::hash(key);
+    uint32_t member = index->members()[index->slot(hash, index->displacements()[index->bucket(hash)])];
+    if (member == FrozenIndex::EMPTY) return nullptr;
+    const Member &found = memberData()[member];
+    return found.key.text() == key ? &found : nullptr;
+}
+
+Json::JNode *Json::JNode::itemData() const {
+    return _value.block ? reinterpret_cast<JNode *>(_value.block + 1) : nullptr;
+}
+
+Json::JNode::Member *Json::JNode::memberData() const {
+    return _value.block ? reinterpret_cast<Member *>(_value.block + 1) : nullptr;
+}
+
+std::string_view Json::JNode::text() const {
+    return _type == String ? std::string_view(_value.text, _length) : std::string_view();
+}
+
+/// 元素逐个移动到新分配的内存块中（JNode 的移动不会抛出异常）
+void Json::JNode::reserve(size_t capacity) {
+    size_t count = size();
+    if (capacity <= (_value.block ? _value.block->capacity : 0) || capacity == 0) return;
+    bool is_array = (_type == Array);
+    Block *block = allocate(capacity, is_array ? sizeof(JNode) : sizeof(Member));
+    for (size_t i = 0; i < count; ++i) {
+        if (is_array) {
+            JNode *to = reinterpret_cast<JNode *>(block + 1);
+            new (to + i) JNode(std::move(itemData()[i]));
+            itemData()[i].~JNode();
+        } else {
+            Member *to = reinterpret_cast<Member *>(block + 1);
+            new (to + i) Member(std::move(memberData()[i]));
+            memberData()[i].~Member();
+        }
+    }
+    block->size = static_cast<uint32_t>(count);
+    ::operator delete(_value.block);
+    _value.block = block;
+}
+
+void Json::JNode::release() noexcept {
+    if (_flags & External) {
+        /// 所在的内存区域整体释放
+    } else if (_type == String) {
+        delete[] _value.text;
+    } else if ((_type == Array || _type == Object) && _value.block) {
+        for (size_t i = 0; i < _value.block->size; ++i) {
+            if (_type == Array)
+                itemData()[i].~JNode();
+            else
+                memberData()[i].~Member();
+        }
+        ::operator delete(_value.block);
+    }
+    _value.integer = 0;
+    _length = 0;
+    _type = Null;
+    _flags = 0;
+}
+
+/// 单遍递归下降解析：直接扫描输入字节并向 Handler 发送事件，不生成中间 Token 序列
+/// Handler 的任一回调返回 false 时立即停止解析
+template<typename Handler>
+class Json::JParser::Reader {
+public:
+    Reader(std::string_view json, Handler &handler) : _json(json), _handler(handler) {}
+    /// 原地解析：含转义的字符串直接在 buffer 中反转义，传给 Handler 的字符串都指向 buffer
+    Reader(char *buffer, size_t size, Handler &handler) : _json(buffer, size), _buffer(buffer), _handler(handler) {}
+
+    bool parse() {
+        skipSpace();
+        if (_pos >= _json.size()) return true;
+        char c = _json[_pos];
+        if (c == '{') {
+            if (!parseObject()) return false;
+        } else if (c == '[') {
+            if (!parseArray()) return false;
+        } else {
+            describe(_pos);
+            throw JException::ParseJsonError("The JSON text does not start with '{' or '['!");
+        }
+        skipSpace();
+        if (_pos < _json.size()) {
+            throw JException::ParseJsonError("Redundant enclosing character '" + describe(_pos) + "'" +
+                                             where(_pos) + "!");
+        }
+        return _handler.onEndDocument();
+    }
+
+    /// 并行解析顶层数组时使用：解析 begin（'[' 或分隔逗号）之后以逗号分隔的元素，直到下一个分隔逗号 end；
+    /// end 为 npos 时解析到数组结尾的 ']'，并检查其后没有多余字符
+    bool parseRange(size_t begin, size_t end) {
+        _pos = begin + 1;
+        if (!_handler.onStartArray()) return false;
+        skipSpace();
+        while (_pos < _json.size()) {
+            if (!parseValue()) return false;
+            skipSpace();
+            if (_pos == end) return _handler.onEndArray();
+            if (_pos > end || _pos >= _json.size()) break;
+            char c = _json[_pos++];
+            if (c == ']' && end == std::string_view::npos) {
+                skipSpace();
+                if (_pos < _json.size()) break;
+                return _handler.onEndArray();
+            }
+            if (c != ',') break;
+            skipSpace();
+        }
+        throw JException::ParseJsonError("Invalid array element" + where(_pos) + "!");
+    }
+
+private:
+    void skipSpace() {
+        while (_pos < _json.size()) {
+            char c = _json[_pos];
+            if (c != ' ' && c != '\n' && c != '\t' && c != '\r') break;
+            _pos++;
+        }
+    }
+
+    std::string where(size_t pos) const {
+        if (_decoded_newlines.empty()) return location(_json, pos);
+        /// 原地反转义写入的换行符不属于原始文本的行
+        size_t line = 1, line_begin = 0;
+        auto decoded = _decoded_newlines.begin();
+        for (size_t i = 0; i < pos && i < _json.size(); ++i) {
+            if (_json[i] != '\n') continue;
+            if (decoded != _decoded_newlines.end() && *decoded == i) {
+                ++decoded;
+                continue;
+            }
+            line++;
+            line_begin = i + 1;
+        }
+        return " at line " + std::to_string(line) + " col " + std::to_string(pos - line_begin + 1);
+    }
+
+    /// 返回位置 pos 处的 Token 名称（与 extract() 中的 Token::type 一致），用于生成错误信息
+    std::string describe(size_t pos) const {
+        char c = _json[pos];
+        switch (c) {
+            case '{': case '}': case '[': case ']': case ',': case ':':
+                return std::string(1, c);
+            case '"':
+                return "string";
+            case 't':
+                checkKeyword(pos, "true");
+                return "bool";
+            case 'f':
+                checkKeyword(pos, "false");
+                return "bool";
+            case 'n':
+                checkKeyword(pos, "null");
+                return "null";
+            default:
+                if (isdigit(static_cast<unsigned char>(c)) || c == '-') return "number";
+                throw JException::ParseJsonError("Unexpected character '" + std::string(1, c) + "'" +
+                                                 where(pos) + "!");
+        }
+    }
+
+    void checkKeyword(size_t pos, std::string_view keyword) const {
+        auto key = _json.substr(pos, keyword.size());
+        if (key != keyword) {
+            throw JException::ParseJsonError("Unexpected keyword \"" + std::string(key) + "\"" + where(pos) + "!");
+        }
+    }
+
+    bool parseObject() {
+        size_t begin = _pos++;
+        size_t comma = std::string_view::npos;
+        if (!_handler.onStartObject()) return false;
+        skipSpace();
+        if (_pos < _json.size() && _json[_pos] == '}') {
+            _pos++;
+            return _handler.onEndObject();
+        }
+        while (_pos < _json.size()) {
+            char c = _json[_pos];
+            if (c != '"') {
+                if (c == '}' && comma != std::string_view::npos) {
+                    throw JException::ParseJsonError("The Object is not completed" + where(comma) + "!");
+                }
+                throw JException::ParseJsonError("Expected '" + describe(_pos) + "'" + where(_pos) +
+                                                 "! Next one should be the key name!");
+            }
+            size_t key_begin = _pos;
+            std::string_view key = decode(key_begin, parseString());
+            skipSpace();
+            if (_pos >= _json.size()) break;
+            if (_json[_pos] != ':') {
+                throw JException::ParseJsonError("Expected '" + describe(_pos) + "'" + where(_pos) +
+                                                 "! Next one should be the ':'!");
+            }
+            _pos++;
+            skipSpace();
+            if (_pos >= _json.size()) break;
+            if (!_handler.onKey(key) || !parseValue()) return false;
+            skipSpace();
+            if (_pos >= _json.size()) break;
+            c = _json[_pos];
+            if (c == '}') {
+                _pos++;
+                return _handler.onEndObject();
+            } else if (c == ',') {
+                comma = _pos++;
+                skipSpace();
+            } else {
+                describe(_pos);
+                break;
+            }
+        }
+        throw JException::ParseJsonError("There is still an uncompleted object from the character '{'" +
+                                         where(begin) + "!");
+    }
+
+    bool parseArray() {
+        size_t begin = _pos++;
+        size_t comma = std::string_view::npos;
+        if (!_handler.onStartArray()) return false;
+        skipSpace();
+        if (_pos < _json.size() && _json[_pos] == ']') {
+            _pos++;
+            return _handler.onEndArray();
+        }
+        while (_pos < _json.size()) {
+            if (_json[_pos] == ']' && comma != std::string_view::npos) {
+                throw JException::ParseJsonError("The Array is not completed" + where(comma) + "!");
+            }
+            if (!parseValue()) return false;
+            skipSpace();
+            if (_pos >= _json.size()) break;
+            char c = _json[_pos];
+            if (c == ']') {
+                _pos++;
+                return _handler.onEndArray();
+            } else if (c == ',') {
+                comma = _pos++;
+                skipSpace();
+            } else if (c == ':') {
+                throw JException::ParseJsonError("Unexpected character ':' in array" + where(_pos) + "!");
+            } else {
+                describe(_pos);
+                break;
+            }
+        }
+        throw JException::ParseJsonError("There is still an uncompleted array from the character '['" +
+                                         where(begin) + "!");
+    }
 
-Json::JObject::constIterator Json::JObject::end() const {
-    return _dict.end();
-}
+    bool parseValue() {
+        char c = _json[_pos];
+        if (c == '{') {
+            return parseObject();
+        } else if (c == '[') {
+            return parseArray();
+        } else if (c == '"') {
+            size_t begin = _pos;
+            return _handler.onString(decode(begin, parseString()));
+        } else if (c == 't' || c == 'f' || c == 'n') {
+            describe(_pos);
+            if (c == 'n') {
+                _pos += 4;
+                return _handler.onNull();
+            }
+            _pos += (c == 't') ? 4 : 5;
+            return _handler.onBool(c == 't');
+        } else if (c == '-' || isdigit(static_cast<unsigned char>(c))) {
+            return parseNumber();
+        }
+        throw JException::ParseJsonError("Can't parse value type '" + describe(_pos) + "'" +
+                                         where(_pos) + "!");
+    }
 
-Json::JObject::iterator Json::JObject::begin() {
-    return _dict.begin();
-}
+    /// 按块查找引号、反斜杠和换行，普通字符不逐个处理；是否含转义记录在 _escaped 中
+    std::string_view parseString() {
+        size_t begin = _pos++;
+        _escaped = false;
+        while (_pos < _json.size()) {
+            _pos = findStringSpecial(_json.data(), _pos, _json.size());
+            if (_pos >= _json.size()) break;
+            char c = _json[_pos++];
+            if (c == '"') {
+                return _json.substr(begin + 1, _pos - begin - 2);
+            } else if (c == '\\') {
+                _escaped = true;
+                if (_pos < _json.size() && _json[_pos] != '\n') _pos++;
+            } else {
+                throw JException::ParseJsonError("The character '\\n' is not supported" + where(_pos - 1) + "!");
+            }
+        }
+        throw JException::ParseJsonError("The character '\"' is not enclosed" + where(begin) + "!");
+    }
 
-Json::JObject::iterator Json::JObject::end() {
-    return _dict.end();
-}
+    /// 刚由 parseString() 读出的字符串（起始引号位于 begin）：不含转义字符时直接返回输入中的原始片段，
+    /// 否则原地或在 _unescaped 中反转义；返回值在下一次解析字符串之前有效
+    std::string_view decode(size_t begin, std::string_view raw) {
+        if (!_escaped) return raw;
+        if (_buffer) return unescapeBuffer(begin + 1, raw.size());
+        _unescaped.clear();
+        size_t error = unescapeInto(raw, _unescaped);
+        if (error != std::string_view::npos) {
+            throw JException::ParseJsonError("The unicode escape sequence is invalid" + where(begin + 1 + error) + "!");
+        }
+        return _unescaped;
+    }
 
-size_t Json::JObject::size() const {
-    return _dict.size();
-}
+    std::string_view unescapeBuffer(size_t begin, size_t size) {
+        size_t error;
+        size_t length = unescapeInPlace(_buffer + begin, size, error);
+        for (size_t i = begin; i < begin + length; ++i) {
+            if (_buffer[i] == '\n') _decoded_newlines.push_back(i);
+        }
+        if (error != std::string_view::npos) {
+            throw JException::ParseJsonError("The unicode escape sequence is invalid" + where(begin + error) + "!");
+        }
+        return {_buffer + begin, length};
+    }
 
-void Json::JObject::set(const std::string &key, const Json::JValue &value) {
-    if (_dict.empty()) {
-        _dict.emplace(key, value);
-        return;
+    bool parseNumber() {
+        std::string_view text = _json.substr(_pos);
+        Number number = parseNumberText(text);
+        if (number.error != NumberError::None) {
+            throw JException::ParseJsonError(numberError(number, text) + where(_pos + number.error_at) + "!");
+        }
+        _pos += number.length;
+        return number.is_integer ? _handler.onInt64(number.integer) : _handler.onDouble(number.real);
     }
-    if (_dict.contains(key)) {
-        _dict[key] = value;
-    } else {
-        _dict.emplace(key, value);
+
+    std::string_view _json;
+    char *_buffer{nullptr};
+    size_t _pos{0};
+    Handler &_handler;
+    std::string _unescaped;
+    std::vector<size_t> _decoded_newlines;
+    bool _escaped{false};
+};
+
+/// 由解析事件构建 JObject / JArray 树
+class Json::JParser::DomBuilder {
+public:
+    DomBuilder(JObject &root_object, JArray &root_array)
+        : _root_object(root_object), _root_array(root_array) {}
+
+    /// 根节点的类型：'{'、'[' 或 0（输入为空）
+    [[nodiscard]] char root() const { return _root; }
+
+    bool onNull() { return add(std::monostate{}); }
+    bool onBool(bool value) { return add(value); }
+    bool onInt64(int64_t value) { return add(narrowInteger(value)); }
+    bool onDouble(double value) { return add(value); }
+    bool onString(std::string_view value) { return add(std::string(value)); }
+
+    bool onKey(std::string_view key) {
+        _keys.emplace_back(key);
+        return true;
     }
-}
 
-void Json::JObject::set(const std::string &key, const Json::JArray &array) {
-    if (_dict.empty()) {
-        _dict.emplace(key, std::make_shared<JArray>(array));
-        return;
+    bool onStartObject() {
+        if (_frames.empty()) _root = '{';
+        _frames.push_back({_values.size(), _keys.size()});
+        return true;
     }
-    if (_dict.contains(key)) {
-        _dict[key] = std::make_shared<JArray>(array);
-    } else {
-        _dict.emplace(key, std::make_shared<JArray>(array));
+
+    bool onStartArray() {
+        if (_frames.empty()) _root = '[';
+        _frames.push_back({_values.size(), _keys.size()});
+        return true;
+    }
+
+    /// 容器闭合时才把暂存的成员移入按实际数量分配的存储中
+    bool onEndObject() {
+        Frame frame = _frames.back();
+        _frames.pop_back();
+        if (_frames.empty()) {
+            fill(_root_object, frame);
+            return true;
+        }
+        auto object = std::make_shared<JObject>();
+        fill(*object, frame);
+        return add(std::move(object));
+    }
+
+    bool onEndArray() {
+        Frame frame = _frames.back();
+        _frames.pop_back();
+        if (_frames.empty()) {
+            fill(_root_array, frame);
+            return true;
+        }
+        auto array = std::make_shared<JArray>();
+        fill(*array, frame);
+        return add(std::move(array));
+    }
+
+    bool onEndDocument() { return true; }
+
+private:
+    struct Frame {
+        size_t values;
+        size_t keys;
+    };
+
+    template<typename T>
+    bool add(T &&value) {
+        _values.emplace_back(std::forward<T>(value));
+        return true;
+    }
+
+    void fill(JObject &object, const Frame &frame) {
+        auto &storage = object.write();
+        storage.reserve(_values.size() - frame.values);
+        for (size_t i = frame.values, k = frame.keys; i < _values.size(); ++i, ++k)
+            storage.insert_or_assign(std::move(_keys[k]), std::move(_values[i]));
+        _values.resize(frame.values);
+        _keys.resize(frame.keys);
+    }
+
+    void fill(JArray &array, const Frame &frame) {
+        std::span<const JValue> items(_values.data() + frame.values, _values.size() - frame.values);
+        if (!array.pack(items)) {
+            auto &values = array.write();
+            values.reserve(items.size());
+            std::move(_values.begin() + static_cast<ptrdiff_t>(frame.values), _values.end(),
+                      std::back_inserter(values));
+        }
+        _values.resize(frame.values);
+    }
+
+    JObject &_root_object;
+    JArray &_root_array;
+    std::vector<Frame> _frames;
+    std::vector<JValue> _values;
+    std::vector<std::string> _keys;
+    char _root{0};
+};
+
+/// 由解析事件构建 JNode 树：值先压入栈中，容器结束时一次性移入大小恰好的内存块
+class Json::JParser::NodeBuilder {
+public:
+    /// resource 为空时节点分配在堆上，否则分配在 resource 中并标记为 External；
+    /// source 非空时，位于其中的字符串（即未经转义处理的）直接引用而不复制
+    explicit NodeBuilder(std::pmr::memory_resource *resource = nullptr, std::string_view source = {})
+        : _resource(resource), _source(source) {}
+
+    JNode take() {
+        return _values.empty() ? JNode() : std::move(_values.front());
+    }
+
+    bool onNull() { return add(JNode()); }
+    bool onBool(bool value) { return add(JNode(value)); }
+    bool onInt64(int64_t value) {
+        if (value >= INT32_MIN && value <= INT32_MAX) return add(JNode(static_cast<int32_t>(value)));
+        return add(JNode(value));
+    }
+    bool onDouble(double value) { return add(JNode(value)); }
+    bool onString(std::string_view value) { return add(text(value)); }
+    bool onKey(std::string_view key) { return add(text(key)); }
+
+    bool onStartObject() {
+        _frames.push_back(_values.size());
+        return true;
+    }
+
+    bool onStartArray() {
+        _frames.push_back(_values.size());
+        return true;
+    }
+
+    bool onEndObject() {
+        size_t begin = _frames.back();
+        size_t count = (_values.size() - begin) / 2;
+        JNode object = JNode::container(JDataType::Object, count, _resource);
+        /// 重复的键与 JObject 一致：保留最后一个值；成员较多时借助临时索引查重
+        bool indexed = count > SMALL_OBJECT;
+        if (indexed) _index.clear();
+        for (size_t i = begin; i + 1 < _values.size(); i += 2) {
+            std::string_view key = _values[i].text();
+            JNode *existing = nullptr;
+            if (!indexed) {
+                existing = object.find(key);
+            } else if (auto found = _index.find(key); found != _index.end()) {
+                existing = &object.memberData()[found->second].value;
+            }
+            if (existing) {
+                *existing = std::move(_values[i + 1]);
+                continue;
+            }
+            if (indexed) _index.emplace(key, object.size());
+            new (object.memberData() + object._value.block->size) JNode::Member{std::move(_values[i]),
+                                                                                 std::move(_values[i + 1])};
+            object._value.block->size++;
+        }
+        return close(begin, std::move(object));
+    }
+
+    bool onEndArray() {
+        size_t begin = _frames.back();
+        JNode array = JNode::container(JDataType::Array, _values.size() - begin, _resource);
+        for (size_t i = begin; i < _values.size(); ++i) {
+            new (array.itemData() + array._value.block->size) JNode(std::move(_values[i]));
+            array._value.block->size++;
+        }
+        return close(begin, std::move(array));
+    }
+
+    bool onEndDocument() { return true; }
+
+private:
+    bool add(JNode &&node) {
+        _values.push_back(std::move(node));
+        return true;
+    }
+
+    JNode text(std::string_view value) const {
+        std::less<const char *> before;
+        if (!_source.empty() && !before(value.data(), _source.data()) &&
+            !before(_source.data() + _source.size(), value.data() + value.size()))
+            return JNode::borrow(value);
+        return JNode::text(value, _resource);
+    }
+
+    bool close(size_t begin, JNode &&container) {
+        _values.resize(begin);
+        _frames.pop_back();
+        return add(std::move(container));
     }
+
+    static constexpr size_t SMALL_OBJECT = 32;
+
+    std::pmr::memory_resource *_resource;
+    std::string_view _source;
+    std::vector<JNode> _values;
+    std::vector<size_t> _frames;
+    std::unordered_map<std::string_view, size_t> _index;
+};
+
+Json::JParser::JParser(Json::JObject root_object)
+    : _root_object(std::move(root_object)) {}
+
+Json::JParser::JParser(Json::JArray root_array)
+    : _root_array(std::move(root_array)) {}
+
+Json::JParser::JParser(const std::string &file_name, uint32_t) {
+    MappedFile file(file_name);
+    if (file.isOpen()) load(file.view());
+}
+
+Json::JParser::JParser() = default;
+
+void Json::JParser::parse(const std::string &json) {
+    load(json);
 }
 
-void Json::JObject::set(const std::string &key, const Json::JObject &object) {
-    if (_dict.empty()) {
-        _dict.emplace(key, std::make_shared<JObject>(object));
+void Json::JParser::load(std::string_view json) {
+    if (json.empty() || loadParallel(json)) return;
+    if (_parse_mode == SinglePass) {
+        JObject object;
+        JArray array;
+        DomBuilder builder(object, array);
+        Reader<DomBuilder>(json, builder).parse();
+        assignRoot(builder.root(), object, array);
         return;
     }
-    if (_dict.contains(key)) {
-        _dict[key] = std::make_shared<JObject>(object);
+    std::vector<Token> tokens = extract(json);
+    if (tokens.empty()) return;
+    size_t pos = 0;
+    JObject object;
+    JArray array;
+    bool is_object = (tokens.front().kind == TokenKind::BeginObject);
+    if (is_object)
+        object = parseObject(json, tokens, pos);
+    else
+        array = parseArray(json, tokens, pos);
+    if (++pos < tokens.size()) {
+        throw JException::ParseJsonError("Redundant enclosing character '" + std::string(tokenName(tokens[pos].kind)) +
+                                         "'" + location(json, tokens[pos].offset) + "!");
+    }
+    if (is_object) {
+        _root_object = std::move(object);
+        _root_array.clear();
     } else {
-        _dict.emplace(key, std::make_shared<JObject>(object));
+        _root_array = std::move(array);
+        _root_object.clear();
     }
 }
 
+bool Json::JParser::parse(const std::string &json, Json::JHandler &handler) {
+    return Reader<JHandler>(json, handler).parse();
+}
 
-Json::JValue & Json::JObject::get(const std::string &key) {
-    auto ptr = _dict.find(key);
-    if (ptr != _dict.end()) {
-        return ptr->second;
-    }
-    throw JException::KeyIsNotFoundException("The key '" + key + "' is not found in object!");
+bool Json::JParser::parseInSitu(char *buffer, size_t size, Json::JHandler &handler) {
+    return Reader<JHandler>(buffer, size, handler).parse();
 }
 
-bool Json::JObject::valid(const std::string &key) {
-    return _dict.contains(key);
+Json::JNode Json::JParser::parseNode(const std::string &json) {
+    return parseNode(json, nullptr);
 }
 
-void Json::JObject::remove(const std::string &key) {
-    if (_dict.contains(key)) {
-        _dict.erase(key);
-    }
+Json::JNode Json::JParser::parseNode(std::string_view json, std::pmr::memory_resource *resource, bool borrow) {
+    NodeBuilder builder(resource, borrow ? json : std::string_view());
+    Reader<NodeBuilder>(json, builder).parse();
+    return builder.take();
 }
 
-void Json::JObject::clear() {
-    _dict.clear();
+Json::JNode Json::JParser::parseNode(char *buffer, size_t size, std::pmr::memory_resource *resource) {
+    NodeBuilder builder(resource, std::string_view(buffer, size));
+    Reader<NodeBuilder>(buffer, size, builder).parse();
+    return builder.take();
 }
 
-bool Json::JObject::toBool(const std::string &key) const {
-    if (!_dict.contains(key)) {
-        throw JException::KeyIsNotFoundException("The key '" + key + "' is not found in object!");
+void Json::JParser::assignRoot(char root, Json::JObject &object, Json::JArray &array) {
+    if (root == '{') {
+        _root_object = std::move(object);
+        _root_array.clear();
+    } else if (root == '[') {
+        _root_array = std::move(array);
+        _root_object.clear();
     }
-    if (std::holds_alternative<bool>(_dict.at(key)))
-        return std::get<bool>(_dict.at(key));
-    else
-        throw JException::GetBadValueException("Can't get value from key '" + key + "'!");
 }
 
-int32_t Json::JObject::toInt(const std::string &key) const {
-    if (!_dict.contains(key)) {
-        throw JException::KeyIsNotFoundException("The key '" + key + "' is not found in object!");
+bool Json::JParser::loadParallel(std::string_view json) {
+    /// 小于 256 KiB 的输入直接单线程解析；每段至少 64 KiB
+    constexpr size_t MIN_BYTES = 256 * 1024, MIN_RANGE = 64 * 1024;
+    if (_threads <= 1 || json.size() < MIN_BYTES) return false;
+    size_t root = json.find_first_not_of(" \n\t\r");
+    if (root == std::string_view::npos || json[root] != '[') return false;
+
+    /// 1. 并行统计各块的引号奇偶性与深度变化，顺序推算每块起点的状态；2. 并行查找各块的第一个顶层逗号
+    auto &pool = WorkerPool::instance();
+    size_t chunks = std::min(_threads * 4, json.size() / MIN_RANGE);
+    auto bound = [&](size_t i) {
+        return root + 1 + (json.size() - root - 1) * i / chunks;
+    };
+    std::vector<SplitScan> scans(chunks);
+    pool.run(chunks, _threads, [&](size_t i) {
+        scans[i] = scanSplit(json, bound(i), bound(i + 1));
+    });
+    std::vector<uint8_t> in_string(chunks);
+    std::vector<int64_t> depth(chunks);
+    bool state = false;
+    int64_t level = 1;
+    for (size_t i = 0; i < chunks; ++i) {
+        in_string[i] = state;
+        depth[i] = level;
+        level += scans[i].depth[state];
+        state = (state != scans[i].quote_parity);
     }
-    if (std::holds_alternative<int32_t>(_dict.at(key)))
-        return std::get<int32_t>(_dict.at(key));
-    else if (std::holds_alternative<int64_t>(_dict.at(key)))
-        return static_cast<int32_t>(std::get<int64_t>(_dict.at(key)));
-    else
-        throw JException::GetBadValueException("Can't get value from key '" + key + "'!");
-}
+    std::vector<size_t> separators(chunks, std::string_view::npos);
+    pool.run(chunks - 1, _threads, [&](size_t i) {
+        separators[i + 1] = findSeparator(json, bound(i + 1), bound(i + 2), in_string[i + 1], depth[i + 1]);
+    });
+    std::vector<size_t> starts{root};
+    for (size_t separator : separators) {
+        if (separator != std::string_view::npos) starts.push_back(separator);
+    }
+    if (starts.size() < 2) return false;
 
-int64_t Json::JObject::toBigInt(const std::string &key) const {
-    if (!_dict.contains(key)) {
-        throw JException::KeyIsNotFoundException("The key '" + key + "' is not found in object!");
+    /// 3. 并行解析各段；任一段出错时返回 false，由单线程解析给出与顺序解析一致的错误信息
+    std::vector<JArray> parts(starts.size());
+    std::atomic<bool> failed{false};
+    pool.run(starts.size(), _threads, [&](size_t i) {
+        JObject unused;
+        DomBuilder builder(unused, parts[i]);
+        size_t end = (i + 1 < starts.size()) ? starts[i + 1] : std::string_view::npos;
+        try {
+            Reader<DomBuilder>(json, builder).parseRange(starts[i], end);
+        } catch (const JException::ParseJsonError &) {
+            failed = true;
+        }
+    });
+    if (failed) return false;
+    size_t total = 0;
+    for (auto &part : parts) total += part.size();
+    JArray array;
+    bool packed = std::all_of(parts.begin(), parts.end(), [&](const JArray &part) {
+        return part._packed && part._packed->real == parts.front()._packed->real;
+    });
+    if (packed) {
+        /// 各段都是同类紧凑数组时直接拼接数值
+        auto merged = std::make_shared<JArray::Packed>();
+        merged->real = parts.front()._packed->real;
+        merged->integers.reserve(merged->real ? 0 : total);
+        merged->doubles.reserve(merged->real ? total : 0);
+        for (auto &part : parts) {
+            merged->integers.insert(merged->integers.end(), part._packed->integers.begin(),
+                                    part._packed->integers.end());
+            merged->doubles.insert(merged->doubles.end(), part._packed->doubles.begin(),
+                                   part._packed->doubles.end());
+        }
+        array._packed = std::move(merged);
+    } else {
+        auto &values = array.write();
+        values.reserve(total);
+        for (auto &part : parts) {
+            std::move(part.write().begin(), part.write().end(), std::back_inserter(values));
+        }
+        array.pack(values);
     }
-    if (std::holds_alternative<int64_t>(_dict.at(key)))
-        return std::get<int64_t>(_dict.at(key));
-    else
-        throw JException::GetBadValueException("Can't get value from key '" + key + "'!");
+    _root_array = std::move(array);
+    _root_object.clear();
+    return true;
 }
 
-float Json::JObject::toFloat(const std::string &key) const {
-    if (!_dict.contains(key)) {
-        throw JException::KeyIsNotFoundException("The key '" + key + "' is not found in object!");
-    }
-    if (std::holds_alternative<float>(_dict.at(key)))
-        return std::get<float>(_dict.at(key));
-    else if (std::holds_alternative<double>(_dict.at(key)))
-        return static_cast<float>(std::get<double>(_dict.at(key)));
-    else
-        throw JException::GetBadValueException("Can't get value from key '" + key + "'!");
+bool Json::JParser::parseFromJsonFile(const std::string &file_name, uint32_t) {
+    MappedFile file(file_name);
+    if (!file.isOpen()) return false;
+    load(file.view());
+    return true;
 }
 
-double Json::JObject::toDouble(const std::string &key) const {
-    if (!_dict.contains(key)) {
-        throw JException::KeyIsNotFoundException("The key '" + key + "' is not found in object!");
-    }
-    if (std::holds_alternative<double>(_dict.at(key)))
-        return std::get<double>(_dict.at(key));
-    else
-        throw JException::GetBadValueException("Can't get value from key '" + key + "'!");
+std::string Json::JParser::dump(uint8_t space) {
+    std::string output;
+    JWriter writer(output, space);
+    writer.setThreads(_threads);
+    dump(writer);
+    return output;
 }
 
-const std::string & Json::JObject::toString(const std::string &key) const {
-    if (!_dict.contains(key)) {
-        throw JException::KeyIsNotFoundException("The key '" + key + "' is not found in object!");
-    }
-    if (std::holds_alternative<std::string>(_dict.at(key)))
-        return std::get<std::string>(_dict.at(key));
+void Json::JParser::dump(Json::JWriter &writer) {
+    if (_root_object.size())
+        writer.write(_root_object);
+    else if (_root_array.size())
+        writer.write(_root_array);
     else
-        throw JException::GetBadValueException("Can't get value from key '" + key + "'!");
+        throw std::runtime_error("You have not select object or array to generate json context!");
 }
 
-const Json::JArray* Json::JObject::toArray(const std::string &key) const {
-    if (!_dict.contains(key)) {
-        throw JException::KeyIsNotFoundException("The key '" + key + "' is not found in object!");
-    }
-    if (std::holds_alternative<std::shared_ptr<JArray>>(_dict.at(key)))
-        return std::get<std::shared_ptr<JArray>>(_dict.at(key)).get();
-    else
-        throw JException::GetBadValueException("Can't get value from key '" + key + "'!");
+std::string Json::JParser::dump(const Json::JNode &node, uint8_t space) {
+    std::string output;
+    JWriter writer(output, space);
+    writer.write(node);
+    return output;
 }
 
-const Json::JObject* Json::JObject::toObject(const std::string &key) const {
-    if (!_dict.contains(key)) {
-        throw JException::KeyIsNotFoundException("The key '" + key + "' is not found in object!");
+bool Json::JParser::dumpToJsonFile(const std::string &file_name, uint8_t space) {
+    std::ofstream file(file_name, std::ios::out);
+    if (!file.is_open()) return false;
+    try {
+        JWriter writer(file, space);
+        writer.setThreads(_threads);
+        dump(writer);
+        writer.flush();
+    } catch (const std::ios_base::failure &) {
+        return false;
     }
-    if (std::holds_alternative<std::shared_ptr<JObject>>(_dict.at(key)))
-        return std::get<std::shared_ptr<JObject>>(_dict.at(key)).get();
-    else
-        throw JException::GetBadValueException("Can't get value from key '" + key + "'!");
+    file.close();
+    return !file.fail();
 }
 
-Json::JValue &Json::JObject::operator[](const std::string &key) {
-    auto ptr = _dict.find(key);
-    if (ptr != _dict.end()) {
-        return ptr->second;
-    } else {
-        /// 默认创建并设定为空值
-        _dict.emplace(key, std::monostate{});
-        return _dict[key];
+Json::JWriter::JWriter(std::string &output, uint8_t space)
+    : _output(&output), _buffer_size(0), _spacer(space, ' '), _compact(space == 0) {}
+
+Json::JWriter::JWriter(std::ostream &stream, uint8_t space, size_t buffer_size)
+    : JWriter([&stream](std::string_view data) {
+          stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+          if (!stream) throw std::ios_base::failure("Failed to write JSON to the stream!");
+      }, space, buffer_size) {}
+
+Json::JWriter::JWriter(int fd, uint8_t space, size_t buffer_size)
+    : JWriter([fd](std::string_view data) {
+          while (!data.empty()) {
+#if defined(_WIN32)
+              int written = _write(fd, data.data(), static_cast<unsigned>(std::min<size_t>(data.size(), INT_MAX)));
+#elif defined(JSONBUILDER_POSIX_FILE)
+              ssize_t written = ::write(fd, data.data(), data.size());
+              if (written < 0 && errno == EINTR) continue;
+#else
+              int written = -1;
+#endif
+              if (written <= 0) throw std::runtime_error("Failed to write JSON to the file descriptor!");
+              data.remove_prefix(static_cast<size_t>(written));
+          }
+      }, space, buffer_size) {}
+
+Json::JWriter::JWriter(Sink sink, uint8_t space, size_t buffer_size)
+    : _output(&_buffer), _sink(std::move(sink)), _buffer_size(buffer_size), _spacer(space, ' '),
+      _compact(space == 0) {
+    _buffer.reserve(buffer_size);
+}
+
+Json::JWriter::~JWriter() {
+    try {
+        flush();
+    } catch (...) {
     }
 }
 
-std::vector<std::string> Json::JObject::keys() const {
-    std::vector<std::string> _keys;
-    for (auto& k : _dict) {
-        _keys.emplace_back(k.first);
+void Json::JWriter::write(const Json::JObject &object) {
+    writeObject(object, 0);
+    spill();
+}
+
+void Json::JWriter::write(const Json::JArray &array) {
+    writeArray(array, 0);
+    spill();
+}
+
+void Json::JWriter::write(const Json::JValue &value) {
+    writeValue(value, 0);
+    spill();
+}
+
+void Json::JWriter::write(const Json::JNode &node) {
+    writeNode(node, 0);
+    spill();
+}
+
+void Json::JWriter::flush() {
+    if (!_sink || _buffer.empty()) return;
+    _sink(_buffer);
+    _buffer.clear();
+}
+
+void Json::JWriter::setThreads(size_t threads) {
+    _threads = threads ? threads : WorkerPool::defaultThreads();
+}
+
+size_t Json::JWriter::threads() const {
+    return _threads;
+}
+
+void Json::JWriter::spill() {
+    if (_sink && _buffer.size() >= _buffer_size) flush();
+}
+
+void Json::JWriter::indent(size_t level) {
+    for (size_t i = 0; i < level; ++i)
+        *_output += _spacer;
+}
+
+/// 元素之前的分隔符与缩进；紧凑模式只在元素之间输出 ','
+void Json::JWriter::next(bool first, size_t level) {
+    if (_compact) {
+        if (!first) *_output += ',';
+        return;
     }
-    return _keys;
+    *_output += first ? "\n" : ", \n";
+    indent(level);
 }
 
-bool Json::JObject::isNull(const std::string &key) const {
-    if (!_dict.contains(key)) {
-        throw JException::KeyIsNotFoundException("The key '" + key + "' is not found in object!");
+void Json::JWriter::close(char bracket, size_t level) {
+    if (!_compact) {
+        *_output += '\n';
+        indent(level);
     }
-    return _dict.at(key).index() == JDataType::Null;
+    *_output += bracket;
 }
 
+/// 元素数达到 MIN_ITEMS 时每 CHUNK_ITEMS 个元素为一段，由单线程的 JWriter 在线程池中写入各自的字符串，
+/// 段内第一个元素之前的分隔符按全局下标输出，因此按顺序拼接后与逐个写入完全相同；
+/// 每轮只格式化 threads * 4 段，拼接并写出后再进行下一轮，缓冲的输出不随容器大小增长
+template<typename Item>
+void Json::JWriter::writeItems(size_t size, size_t level, const Item &item) {
+    constexpr size_t MIN_ITEMS = 16 * 1024, CHUNK_ITEMS = 4 * 1024;
+    if (_threads <= 1 || size < MIN_ITEMS) {
+        for (size_t i = 0; i < size; ++i) {
+            next(i == 0, level + 1);
+            item(*this, i);
+            spill();
+        }
+        return;
+    }
+    size_t chunks = (size + CHUNK_ITEMS - 1) / CHUNK_ITEMS;
+    std::vector<std::string> parts(std::min(_threads * 4, chunks));
+    auto space = static_cast<uint8_t>(_spacer.size());
+    for (size_t first = 0; first < chunks; first += parts.size()) {
+        size_t count = std::min(parts.size(), chunks - first);
+        WorkerPool::instance().run(count, _threads, [&](size_t k) {
+            parts[k].clear();
+            JWriter part(parts[k], space);
+            size_t begin = (first + k) * CHUNK_ITEMS, end = std::min(size, begin + CHUNK_ITEMS);
+            for (size_t i = begin; i < end; ++i) {
+                part.next(i == 0, level + 1);
+                item(part, i);
+            }
+        });
+        for (size_t k = 0; k < count; ++k) {
+            *_output += parts[k];
+            spill();
+        }
+    }
+}
 
-Json::JArray::JArray() = default;
+void Json::JWriter::writeKey(std::string_view key) {
+    writeString(key);
+    *_output += _compact ? ":" : ": ";
+}
 
-Json::JArray::JArray(const std::vector<JValue> &&values) : _dict(values) {}
+void Json::JWriter::writeString(std::string_view value) {
+    *_output += '"';
+    escapeInto(value, *_output);
+    *_output += '"';
+}
 
-Json::JArray::constIterator Json::JArray::begin() const {
-    return _dict.begin();
+void Json::JWriter::writeValue(const Json::JValue &value, size_t level) {
+    std::string &output = *_output;
+    switch (value.index()) {
+        case JDataType::Null: output += "null"; break;
+        case JDataType::Bool: output += std::get<bool>(value) ? "true" : "false"; break;
+        case JDataType::Int: appendInteger(std::get<int32_t>(value), output); break;
+        case JDataType::BigInt: appendInteger(std::get<int64_t>(value), output); break;
+        case JDataType::Float: appendReal(std::get<float>(value), output); break;
+        case JDataType::Double: appendReal(std::get<double>(value), output); break;
+        case JDataType::String: writeString(std::get<std::string>(value)); break;
+        case JDataType::Array: writeArray(*std::get<std::shared_ptr<JArray>>(value), level); break;
+        case JDataType::Object: writeObject(*std::get<std::shared_ptr<JObject>>(value), level); break;
+        default: break;
+    }
 }
 
-Json::JArray::constIterator Json::JArray::end() const {
-    return _dict.end();
+void Json::JWriter::writeObject(const Json::JObject &object, size_t level) {
+    if (!object.size()) {
+        *_output += "{}";
+        return;
+    }
+    *_output += '{';
+    auto members = object.begin();
+    writeItems(object.size(), level, [&](JWriter &writer, size_t i) {
+        writer.writeKey(members[i].first);
+        writer.writeValue(members[i].second, level + 1);
+    });
+    close('}', level);
 }
 
-Json::JArray::iterator Json::JArray::begin() {
-    return _dict.begin();
+void Json::JWriter::writeArray(const Json::JArray &array, size_t level) {
+    size_t size = array.size();
+    if (!size) {
+        *_output += "[]";
+        return;
+    }
+    *_output += '[';
+    std::span<const int64_t> integers = array.integers();
+    std::span<const double> reals = array.doubles();
+    if (!integers.empty() || !reals.empty()) {
+        /// 紧凑存储的数值直接格式化，与逐个 JValue 格式化的输出一致
+        writeItems(size, level, [&](JWriter &writer, size_t i) {
+            if (integers.empty())
+                appendReal(reals[i], *writer._output);
+            else
+                appendInteger(integers[i], *writer._output);
+        });
+    } else {
+        writeItems(size, level, [&](JWriter &writer, size_t i) { writer.writeValue(array.get(i), level + 1); });
+    }
+    close(']', level);
 }
 
-Json::JArray::iterator Json::JArray::end() {
-    return _dict.end();
+/// 与 writeObject / writeArray 的输出格式一致
+void Json::JWriter::writeNode(const Json::JNode &node, size_t level) {
+    std::string &output = *_output;
+    switch (node.type()) {
+        case JDataType::Null: output += "null"; return;
+        case JDataType::Bool: output += node._value.boolean ? "true" : "false"; return;
+        case JDataType::Int:
+        case JDataType::BigInt: appendInteger(node._value.integer, output); return;
+        case JDataType::Float: appendReal(node._value.real32, output); return;
+        case JDataType::Double: appendReal(node._value.real, output); return;
+        case JDataType::String: writeString(node.text()); return;
+        default: break;
+    }
+    bool is_object = (node.type() == JDataType::Object);
+    size_t size = node.size();
+    if (!size) {
+        output += is_object ? "{}" : "[]";
+        return;
+    }
+    output += is_object ? '{' : '[';
+    writeItems(size, level, [&](JWriter &writer, size_t i) {
+        if (is_object) {
+            const JNode::Member &member = node.memberData()[i];
+            writer.writeKey(member.key.text());
+            writer.writeNode(member.value, level + 1);
+        } else {
+            writer.writeNode(node.itemData()[i], level + 1);
+        }
+    });
+    close(is_object ? '}' : ']', level);
 }
 
-size_t Json::JArray::size() const {
-    return _dict.size();
+const Json::JObject & Json::JParser::object() const {
+    return _root_object;
 }
 
-size_t Json::JArray::length() const {
-    return _dict.size();
+const Json::JArray & Json::JParser::array() const {
+    return _root_array;
 }
 
-const Json::JValue &Json::JArray::get(size_t index) const {
-    return _dict.at(index);
+void Json::JParser::setRootObject(Json::JObject root_object) {
+    _root_object = std::move(root_object);
+    _root_array.clear();
 }
 
-bool Json::JArray::isNull(size_t index) const {
-    return _dict.at(index).index() == JDataType::Null;
+void Json::JParser::setRootArray(Json::JArray root_array) {
+    _root_array = std::move(root_array);
+    _root_object.clear();
 }
 
-bool Json::JArray::toBool(size_t index) const {
-    if (std::holds_alternative<bool>(_dict.at(index)))
-        return std::get<bool>(_dict.at(index));
-    else
-        throw JException::GetBadValueException("Can't get value from index '" + std::to_string(index) + "'!");
+void Json::JParser::setParseMode(Json::JParser::ParseMode mode) {
+    _parse_mode = mode;
 }
 
-int32_t Json::JArray::toInt(size_t index) const {
-    if (std::holds_alternative<int32_t>(_dict.at(index)))
-        return std::get<int32_t>(_dict.at(index));
-    else if (std::holds_alternative<int64_t>(_dict.at(index)))
-        return static_cast<int32_t>(std::get<int64_t>(_dict.at(index)));
-    else
-        throw JException::GetBadValueException("Can't get value from index '" + std::to_string(index) + "'!");
+Json::JParser::ParseMode Json::JParser::parseMode() const {
+    return _parse_mode;
 }
 
-int64_t Json::JArray::toBigInt(size_t index) const {
-    if (std::holds_alternative<int32_t>(_dict.at(index)))
-        return std::get<int32_t>(_dict.at(index));
-    else if (std::holds_alternative<int64_t>(_dict.at(index)))
-        return std::get<int64_t>(_dict.at(index));
-    else
-        throw JException::GetBadValueException("Can't get value from index '" + std::to_string(index) + "'!");
+void Json::JParser::setThreads(size_t threads) {
+    _threads = threads ? threads : WorkerPool::defaultThreads();
 }
 
-float Json::JArray::toFloat(size_t index) const {
-    if (std::holds_alternative<float>(_dict.at(index)))
-        return std::get<float>(_dict.at(index));
-    else if (std::holds_alternative<double>(_dict.at(index)))
-        return static_cast<float>(std::get<double>(_dict.at(index)));
-    else
-        throw JException::GetBadValueException("Can't get value from index '" + std::to_string(index) + "'!");
+size_t Json::JParser::threads() const {
+    return _threads;
 }
 
-double Json::JArray::toDouble(size_t index) const {
-    if (std::holds_alternative<float>(_dict.at(index)))
-        return static_cast<double>(std::get<float>(_dict.at(index)));
-    else if (std::holds_alternative<double>(_dict.at(index)))
-        return std::get<double>(_dict.at(index));
-    else
-        throw JException::GetBadValueException("Can't get value from index '" + std::to_string(index) + "'!");
+std::string Json::JParser::location(std::string_view json, size_t pos) {
+    size_t line = 1, line_begin = 0;
+    for (size_t i = 0; i < pos && i < json.size(); ++i) {
+        if (json[i] == '\n') {
+            line++;
+            line_begin = i + 1;
+        }
+    }
+    return " at line " + std::to_string(line) + " col " + std::to_string(pos - line_begin + 1);
 }
 
-const std::string &Json::JArray::toString(size_t index) const {
-    if (std::holds_alternative<std::string>(_dict.at(index)))
-        return std::get<std::string>(_dict.at(index));
-    else
-        throw JException::GetBadValueException("Can't get value from index '" + std::to_string(index) + "'!");
+const char *Json::JParser::tokenName(Json::JParser::TokenKind kind) {
+    switch (kind) {
+        case TokenKind::BeginObject: return "{";
+        case TokenKind::EndObject: return "}";
+        case TokenKind::BeginArray: return "[";
+        case TokenKind::EndArray: return "]";
+        case TokenKind::Comma: return ",";
+        case TokenKind::Colon: return ":";
+        case TokenKind::String: return "string";
+        case TokenKind::Number: return "number";
+        case TokenKind::True:
+        case TokenKind::False: return "bool";
+        case TokenKind::Null: return "null";
+    }
+    return "";
 }
 
-const Json::JArray *Json::JArray::toArray(size_t index) const {
-    if (std::holds_alternative<std::shared_ptr<JArray>>(_dict.at(index)))
-        return std::get<std::shared_ptr<JArray>>(_dict.at(index)).get();
-    else
-        throw JException::GetBadValueException("Can't get value from index '" + std::to_string(index) + "'!");
+std::vector<uint32_t> Json::JParser::structuralIndex(std::string_view json, size_t &string_newline) {
+    static const IndexFunction index_function = selectIndexFunction();
+    if (json.size() > UINT32_MAX) {
+        throw JException::ParseJsonError("The JSON text is too large for the two-pass parser!");
+    }
+    std::vector<uint32_t> index;
+    index.reserve(json.size() / 8 + BLOCK_SIZE);
+    IndexState state;
+    index_function(json, state, index);
+    string_newline = state.string_newline;
+    return index;
 }
 
-const Json::JObject *Json::JArray::toObject(size_t index) const {
-    if (std::holds_alternative<std::shared_ptr<JObject>>(_dict.at(index)))
-        return std::get<std::shared_ptr<JObject>>(_dict.at(index)).get();
-    else
-        throw JException::GetBadValueException("Can't get value from index '" + std::to_string(index) + "'!");
+std::vector<Json::JParser::Token> Json::JParser::extract(std::string_view json) {
+    size_t string_newline;
+    std::vector<uint32_t> index = structuralIndex(json, string_newline);
+    std::vector<Token> tokens;
+    tokens.reserve(index.size());
+    auto emit = [&tokens](Token token) {
+        tokens.push_back(token);
+        if (tokens.size() == 1 && token.kind != TokenKind::BeginObject && token.kind != TokenKind::BeginArray) {
+            throw JException::ParseJsonError("The JSON text does not start with '{' or '['!");
+        }
+    };
+    auto is_delimiter = [&json](size_t i) {
+        switch (json[i]) {
+            case ' ': case '\n': case '\t': case '\r': case '"':
+            case '{': case '}': case '[': case ']': case ',': case ':':
+                return true;
+            default:
+                return false;
+        }
+    };
+    auto keyword = [&json](size_t &i, std::string_view word, TokenKind kind) -> Token {
+        auto key = json.substr(i, word.size());
+        if (key != word) {
+            throw JException::ParseJsonError("Unexpected keyword \"" + std::string(key) + "\"" +
+                                             location(json, i) + "!");
+        }
+        i += word.size();
+        return {i - word.size(), static_cast<uint32_t>(word.size()), kind};
+    };
+    for (size_t n = 0; n < index.size(); ++n) {
+        size_t i = index[n];
+        char c = json[i];
+        switch (c) {
+            case '{': emit({i, 1, TokenKind::BeginObject}); break;
+            case '}': emit({i, 1, TokenKind::EndObject}); break;
+            case '[': emit({i, 1, TokenKind::BeginArray}); break;
+            case ']': emit({i, 1, TokenKind::EndArray}); break;
+            case ',': emit({i, 1, TokenKind::Comma}); break;
+            case ':': emit({i, 1, TokenKind::Colon}); break;
+            case '"': {
+                /// 字符串内部的字符不会进入索引，下一个索引项必然是闭合引号
+                size_t end = (n + 1 < index.size()) ? index[++n] : json.size();
+                if (string_newline > i && string_newline < end) {
+                    throw JException::ParseJsonError("The character '\\n' is not supported" +
+                                                     location(json, string_newline) + "!");
+                }
+                if (end == json.size()) {
+                    throw JException::ParseJsonError("The character '\"' is not enclosed" + location(json, i) + "!");
+                }
+                emit({i, static_cast<uint32_t>(end - i + 1), TokenKind::String});
+                break;
+            }
+            default:
+                /// 标量只在起始位置进入索引，逐个切分直到遇到空白、引号或结构字符
+                do {
+                    c = json[i];
+                    if (c == 't') {
+                        emit(keyword(i, "true", TokenKind::True));
+                    } else if (c == 'f') {
+                        emit(keyword(i, "false", TokenKind::False));
+                    } else if (c == 'n') {
+                        emit(keyword(i, "null", TokenKind::Null));
+                    } else if (isdigit(static_cast<unsigned char>(c)) || c == '-') {
+                        emit(extractNumber(json, i));
+                    } else {
+                        throw JException::ParseJsonError("Unexpected character '" + std::string(1, c) + "'" +
+                                                         location(json, i) + "!");
+                    }
+                } while (i < json.size() && !is_delimiter(i));
+        }
+    }
+    return tokens;
 }
 
-void Json::JArray::pushBack(const Json::JValue &value) {
-    _dict.push_back(value);
+Json::JParser::Token Json::JParser::extractNumber(std::string_view json, size_t &pos) {
+    size_t begin = pos;
+    std::string_view text = json.substr(pos);
+    Number number = parseNumberText(text);
+    if (number.error != NumberError::None) {
+        throw JException::ParseJsonError(numberError(number, text) + location(json, pos + number.error_at) + "!");
+    }
+    pos += number.length;
+    return {begin, static_cast<uint32_t>(number.length), TokenKind::Number};
 }
 
-void Json::JArray::pushBack(const Json::JArray &array) {
-    _dict.push_back(std::make_shared<JArray>(array));
+Json::JObject Json::JParser::parseObject(std::string_view json, const std::vector<Token> &tokens, size_t &pos) {
+    Json::JObject result;
+    size_t begin = pos++;
+    if (pos < tokens.size() && tokens[pos].kind == TokenKind::EndObject) return result;
+    while (pos < tokens.size()) {
+        const Token &token = tokens[pos];
+        if (token.kind != TokenKind::String) {
+            if (token.kind == TokenKind::EndObject) {
+                throw JException::ParseJsonError("The Object is not completed" +
+                                                 location(json, tokens[pos - 1].offset) + "!");
+            }
+            throw JException::ParseJsonError("Expected '" + std::string(tokenName(token.kind)) + "'" +
+                                             location(json, token.offset) + "! Next one should be the key name!");
+        }
+        std::string key;
+        size_t error = unescapeInto(json.substr(token.offset + 1, token.length - 2), key);
+        if (error != std::string_view::npos) {
+            throw JException::ParseJsonError("The unicode escape sequence is invalid" +
+                                             location(json, token.offset + 1 + error) + "!");
+        }
+        if (++pos >= tokens.size()) break;
+        if (tokens[pos].kind != TokenKind::Colon) {
+            throw JException::ParseJsonError("Expected '" + std::string(tokenName(tokens[pos].kind)) + "'" +
+                                             location(json, tokens[pos].offset) + "! Next one should be the ':'!");
+        }
+        if (++pos >= tokens.size()) break;
+        parseValue(json, tokens, pos, result.write().insert_or_assign(std::move(key), std::monostate{}));
+        if (++pos >= tokens.size()) break;
+        if (tokens[pos].kind == TokenKind::EndObject) {
+            return result;
+        } else if (tokens[pos].kind == TokenKind::Comma) {
+            pos++;
+            continue;
+        }
+        break;
+    }
+    throw JException::ParseJsonError("There is still an uncompleted object from the character '{'" +
+                                     location(json, tokens[begin].offset) + "!");
 }
 
-void Json::JArray::pushBack(const Json::JObject &object) {
-    _dict.push_back(std::make_shared<JObject>(object));
+void Json::JParser::parseValue(std::string_view json, const std::vector<Token> &tokens, size_t &pos,
+                               Json::JValue &value) {
+    const Token &token = tokens[pos];
+    switch (token.kind) {
+        case TokenKind::BeginObject:
+            value = std::make_shared<JObject>(parseObject(json, tokens, pos));
+            break;
+        case TokenKind::BeginArray:
+            value = std::make_shared<JArray>(parseArray(json, tokens, pos));
+            break;
+        case TokenKind::String: {
+            std::string text;
+            size_t error = unescapeInto(json.substr(token.offset + 1, token.length - 2), text);
+            if (error != std::string_view::npos) {
+                throw JException::ParseJsonError("The unicode escape sequence is invalid" +
+                                                 location(json, token.offset + 1 + error) + "!");
+            }
+            value = std::move(text);
+            break;
+        }
+        case TokenKind::Number: {
+            Number number = parseNumberText(json.substr(token.offset, token.length));
+            if (number.is_integer)
+                value = narrowInteger(number.integer);
+            else
+                value = number.real;
+            break;
+        }
+        case TokenKind::True:
+            value = true;
+            break;
+        case TokenKind::False:
+            value = false;
+            break;
+        case TokenKind::Null:
+            value = std::monostate{};
+            break;
+        default:
+            throw JException::ParseJsonError("Can't parse value type '" + std::string(tokenName(token.kind)) + "'" +
+                                             location(json, token.offset) + "!");
+    }
 }
 
-void Json::JArray::pushFront(const Json::JValue &value) {
-    _dict.insert(_dict.begin(), value);
+Json::JArray Json::JParser::parseArray(std::string_view json, const std::vector<Token> &tokens, size_t &pos) {
+    Json::JArray result;
+    size_t begin = pos++;
+    if (pos < tokens.size() && tokens[pos].kind == TokenKind::EndArray) return result;
+    while (pos < tokens.size()) {
+        if (tokens[pos].kind == TokenKind::EndArray) {
+            throw JException::ParseJsonError("The Array is not completed" +
+                                             location(json, tokens[pos - 1].offset) + "!");
+        }
+        parseValue(json, tokens, pos, result.write().push_back(std::monostate{}));
+        if (++pos >= tokens.size()) break;
+        if (tokens[pos].kind == TokenKind::EndArray) {
+            result.pack(std::as_const(result._dict));
+            return result;
+        } else if (tokens[pos].kind == TokenKind::Comma) {
+            pos++;
+            continue;
+        } else if (tokens[pos].kind == TokenKind::Colon) {
+            throw JException::ParseJsonError("Unexpected character ':' in array" +
+                                             location(json, tokens[pos].offset) + "!");
+        }
+        break;
+    }
+    throw JException::ParseJsonError("There is still an uncompleted array from the character '['" +
+                                     location(json, tokens[begin].offset) + "!");
 }
 
-void Json::JArray::pushFront(const Json::JArray &array) {
-    _dict.insert(_dict.begin(), std::make_shared<JArray>(array));
-}
+/// 单调增长的内存区域：只分配、不单独释放；clear() 时只保留最大的一块供下次解析复用
+class Json::JDocument::Arena : public std::pmr::memory_resource {
+public:
+    Arena() = default;
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
 
-void Json::JArray::pushFront(const Json::JObject &object) {
-    _dict.insert(_dict.begin(), std::make_shared<JObject>(object));
-}
+    ~Arena() override {
+        for (auto &chunk : _chunks) ::operator delete(chunk.data);
+    }
 
-void Json::JArray::append(const Json::JValue &value) {
-    _dict.push_back(value);
-}
+    void clear() {
+        if (_chunks.empty()) return;
+        auto largest = std::max_element(_chunks.begin(), _chunks.end(),
+                                        [](const Chunk &a, const Chunk &b) { return a.size < b.size; });
+        Chunk keep = *largest;
+        for (auto &chunk : _chunks) {
+            if (chunk.data != keep.data) ::operator delete(chunk.data);
+        }
+        _chunks.assign(1, keep);
+        _pos = 0;
+    }
 
-void Json::JArray::append(const Json::JArray &array) {
-    _dict.emplace_back(std::make_shared<JArray>(array));
-}
+    /// 预计还需要 bytes 字节时，让下一次申请的块至少这么大
+    void expect(size_t bytes) {
+        _next = std::max(_next, bytes);
+    }
 
-void Json::JArray::append(const Json::JObject &object) {
-    _dict.emplace_back(std::make_shared<JObject>(object));
-}
+    [[nodiscard]] size_t reservedBytes() const {
+        size_t total = 0;
+        for (auto &chunk : _chunks) total += chunk.size;
+        return total;
+    }
 
-void Json::JArray::insert(size_t index, const Json::JValue &value) {
-    _dict.insert(_dict.begin() + index, value);
-}
+private:
+    struct Chunk {
+        char *data;
+        size_t size;
+    };
 
-void Json::JArray::insert(size_t index, const Json::JArray &value) {
-    _dict.insert(_dict.begin() + index, std::make_shared<JArray>(value));
-}
+    /// ::operator new 返回的地址按 __STDCPP_DEFAULT_NEW_ALIGNMENT__ 对齐，块内按偏移对齐即可
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        size_t pos = (_pos + alignment - 1) & ~(alignment - 1);
+        if (_chunks.empty() || pos + bytes > _chunks.back().size) {
+            size_t size = std::max(_next, bytes + alignment);
+            _chunks.push_back({static_cast<char *>(::operator new(size)), size});
+            _next = size * 2;
+            pos = 0;
+        }
+        _pos = pos + bytes;
+        return _chunks.back().data + pos;
+    }
 
-void Json::JArray::insert(size_t index, const Json::JObject &value) {
-    _dict.insert(_dict.begin() + index, std::make_shared<JObject>(value));
-}
+    void do_deallocate(void *, size_t, size_t) override {}
 
-void Json::JArray::remove(size_t index) {
-    _dict.erase(_dict.begin() + index);
-}
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
 
-void Json::JArray::popFront() {
-    _dict.erase(_dict.begin());
-}
+    std::vector<Chunk> _chunks;
+    size_t _pos{0};
+    size_t _next{64 * 1024};
+};
 
-void Json::JArray::popBack() {
-    _dict.pop_back();
-}
+Json::JDocument::JDocument() : _arena(std::make_unique<Arena>()) {}
 
-void Json::JArray::clear() {
-    _dict.clear();
+Json::JDocument::JDocument(Json::JDocument &&other) noexcept = default;
+
+Json::JDocument &Json::JDocument::operator=(Json::JDocument &&other) noexcept = default;
+
+Json::JDocument::~JDocument() = default;
+
+void Json::JDocument::parse(const std::string &json) {
+    load(json);
 }
 
-void Json::JArray::sort(const std::function<bool(JValue&, JValue&)> &sort_function) {
-    if (sort_function) {
-        std::sort(_dict.begin(), _dict.end(), sort_function);
+void Json::JDocument::freeze(const Json::JObject &object) {
+    clear();
+    if (!_arena) _arena = std::make_unique<Arena>();
+    try {
+        _root = JNode::frozen(object, _arena.get());
+    } catch (...) {
+        clear();
+        throw;
     }
 }
 
-Json::JArray& Json::JArray::operator<<(const Json::JValue &value) {
-    _dict.push_back(value);
-    return *this;
+void Json::JDocument::freeze(const Json::JArray &array) {
+    clear();
+    if (!_arena) _arena = std::make_unique<Arena>();
+    try {
+        _root = JNode::frozen(array, _arena.get());
+    } catch (...) {
+        clear();
+        throw;
+    }
 }
 
-Json::JArray& Json::JArray::operator<<(const Json::JArray &array) {
-    _dict.emplace_back(std::make_shared<JArray>(array));
-    return *this;
+void Json::JDocument::parseRetained(std::string json) {
+    clear();
+    if (!_source) _source = std::make_unique<std::string>();
+    *_source = std::move(json);
+    load(*_source, true);
 }
 
-Json::JArray& Json::JArray::operator<<(const Json::JObject &object) {
-    _dict.emplace_back(std::make_shared<JObject>(object));
-    return *this;
+void Json::JDocument::parseInSitu(char *buffer, size_t size) {
+    clear();
+    if (!_arena) _arena = std::make_unique<Arena>();
+    _arena->expect(size);
+    try {
+        _root = JParser::parseNode(buffer, size, _arena.get());
+    } catch (...) {
+        clear();
+        throw;
+    }
 }
 
-Json::JValue& Json::JArray::operator[](size_t index) {
-    return _dict.at(index);
+bool Json::JDocument::parseFromJsonFile(const std::string &file_name) {
+    MappedFile file(file_name);
+    if (!file.isOpen()) return false;
+    load(file.view());
+    return true;
 }
 
-Json::JParser::JParser(Json::JObject root_object)
-    : _root_object(std::move(root_object)) {}
-
-Json::JParser::JParser(Json::JArray root_array)
-    : _root_array(std::move(root_array)) {}
-
-Json::JParser::JParser(const std::string &file_name, uint32_t max_cols_inline) {
-    std::ifstream file(file_name, std::ios::in);
-    std::string json;
-    if (!file.is_open()) return;
-    char *buf = (char*) calloc(max_cols_inline, sizeof(char));
-    while (true) {
-        file.getline(buf, max_cols_inline);
-        json += buf;
-        if (!file.eof()) json += "\n"; else break;
-    }
-    free(buf);
-    file.close();
-    parse(json);
+void Json::JDocument::clear() {
+    _root = JNode();
+    if (_arena) _arena->clear();
+    if (_source) _source->clear();
 }
 
-Json::JParser::JParser() = default;
+const Json::JNode &Json::JDocument::root() const {
+    return _root;
+}
 
-void Json::JParser::parse(const std::string &json) {
-    uint32_t line = 1, col = 1;
-    if (json.empty()) return;
-    std::vector<Token> tokens = extract(json, line, col);
-    size_t pos = 0;
-    if (tokens.front().type == "{")
-        _root_object = parseObject(tokens, pos);
-    else
-        _root_array = parseArray(tokens, pos);
+std::string_view Json::JDocument::source() const {
+    return _source ? std::string_view(*_source) : std::string_view();
 }
 
-bool Json::JParser::parseFromJsonFile(const std::string &file_name, uint32_t max_cols_inline) {
-    std::ifstream file(file_name, std::ios::in);
-    std::string json;
-    if (!file.is_open()) return false;
-    char *buf = (char*) calloc(max_cols_inline, sizeof(char));
-    while (true) {
-        file.getline(buf, max_cols_inline);
-        json += buf;
-        if (!file.eof()) json += "\n"; else break;
-    }
-    free(buf);
-    file.close();
-    parse(json);
-    return true;
+size_t Json::JDocument::reservedBytes() const {
+    return _arena ? _arena->reservedBytes() : 0;
 }
 
-std::string Json::JParser::dump(uint8_t space) {
-    std::string output;
-    std::string spacer;
-    for (int i = 0; i < space; ++i) {
-        spacer += " ";
+void Json::JDocument::load(std::string_view json, bool borrow) {
+    if (!borrow) clear();
+    if (!_arena) _arena = std::make_unique<Arena>();
+    _arena->expect(json.size());
+    try {
+        _root = JParser::parseNode(json, _arena.get(), borrow);
+    } catch (...) {
+        clear();
+        throw;
     }
-    if (_root_object.size())
-        output = parseObject(_root_object, spacer, 0);
-    else if (_root_array.size())
-        output = parseArray(&_root_array, spacer, 0);
-    else
-        throw std::runtime_error("You have not select object or array to generate json context!");
-    return output;
 }
 
-bool Json::JParser::dumpToJsonFile(const std::string &file_name, uint8_t space) {
-    std::ofstream file(file_name, std::ios::out);
-    if (!file.is_open()) return false;
-    std::string json = dump(space);
-    file << json;
-    file.close();
-    return true;
-}
+Json::JStreamParser::JStreamParser(Json::JHandler &handler)
+    : _handler(handler) {}
 
-std::string
-Json::JParser::parseObject(const JObject &object, const std::string &spacer, uint8_t indentation_level) {
-    std::string output;
-    size_t _idx = 0, _size = object.size();
-    output += "{";
-    if (!_size) {
-        output += "}";
-        return output;
-    }
-    output += "\n";
-    for (auto& _r : object) {
-        for (int i = 0; i < indentation_level + 1; ++i)
-            output += spacer;
-        output += "\"" + _r.first + "\": ";
-        if (_r.second.index() == JDataType::Null) {
-            output += "null";
-        } else if (_r.second.index() == JDataType::Bool) {
-            output += (std::get<bool>(_r.second) ? "true" : "false");
-        } else if (_r.second.index() == JDataType::Int) {
-            output += std::to_string(std::get<int32_t>(_r.second));
-        } else if (_r.second.index() == JDataType::BigInt) {
-            output += std::to_string(std::get<int64_t>(_r.second));
-        } else if (_r.second.index() == JDataType::Float) {
-            output += stripZero(std::get<float>(_r.second));
-        } else if (_r.second.index() == JDataType::Double) {
-            output += stripZero(std::get<double>(_r.second));
-        } else if (_r.second.index() == JDataType::String) {
-            auto s = escToString(std::get<std::string>(_r.second));
-            output += "\"" + s + "\"";
-        } else if (_r.second.index() == JDataType::Array) {
-            output += parseArray(std::get<std::shared_ptr<JArray>>(_r.second).get(), spacer, indentation_level + 1);
-        } else if (_r.second.index() == JDataType::Object) {
-            output += parseObject(*std::get<std::shared_ptr<JObject>>(_r.second), spacer, indentation_level + 1);
-        }
-        if (++_idx < _size) {
-            output += ", \n";
-        }
-    }
-    output += "\n";
-    for (int i = 0; i < indentation_level; ++i)
-        output += spacer;
-    output += "}";
-    return output;
+bool Json::JStreamParser::feed(std::string_view data) {
+    return feed(data.data(), data.size());
 }
 
-std::string Json::JParser::parseArray(const Json::JArray *array, const std::string &spacer,
-                                      uint8_t indentation_level) {
-    std::string array_text;
-    array_text += "[";
-    size_t _idx = 0;
-    size_t _size = array->size();
-    if (!_size) {
-        array_text += "]";
-        return array_text;
-    }
-    array_text += "\n";
-    for (auto& i : *array) {
-        for (int j = 0; j < indentation_level + 1; ++j)
-            array_text += spacer;
-        if (i.index() == Json::JDataType::Null) {
-            array_text += "null";
-        } else if (i.index() == Json::JDataType::Bool) {
-            array_text += (std::get<bool>(i) ? "true" : "false");
-        } else if (i.index() == Json::JDataType::Int) {
-            array_text += std::to_string(std::get<int>(i));
-        } else if (i.index() == Json::JDataType::BigInt) {
-            array_text += std::to_string(std::get<int64_t>(i));
-        } else if (i.index() == Json::JDataType::Float) {
-            array_text += stripZero(std::get<float>(i));
-        } else if (i.index() == Json::JDataType::Double) {
-            array_text += stripZero(std::get<double>(i));
-        } else if (i.index() == Json::JDataType::String) {
-            auto s = escToString(std::get<std::string>(i));
-            array_text += "\"" + s + "\"";
-        } else if (i.index() == Json::JDataType::Array) {
-            array_text += parseArray(std::get<std::shared_ptr<JArray>>(i).get(), spacer, indentation_level + 1);
-        } else if (i.index() == Json::JDataType::Object) {
-            array_text += parseObject(*std::get<std::shared_ptr<JObject>>(i), spacer, indentation_level + 1);
-        }
-        if (++_idx < _size) {
-            array_text += ", \n";
+bool Json::JStreamParser::feed(const char *data, size_t size) {
+    if (_stopped) return false;
+    _data = data;
+    _size = size;
+    _pos = 0;
+    bool running = true;
+    while (running && _pos < _size) {
+        if (_lexer == Lexer::String || _lexer == Lexer::Escape) {
+            running = scanString();
+        } else if (_lexer == Lexer::Scalar) {
+            running = scanScalar();
         } else {
-            array_text += "\n";
+            char c = _data[_pos];
+            if (c == ' ' || c == '\t' || c == '\r') {
+                _pos++;
+            } else if (c == '\n') {
+                _line++;
+                _line_begin = _offset + ++_pos;
+            } else {
+                running = structure(c);
+            }
         }
     }
-    for (int j = 0; j < indentation_level; ++j)
-        array_text += spacer;
-    array_text += "]";
-    return array_text;
+    _offset += _size;
+    _data = nullptr;
+    _size = _pos = 0;
+    _stopped = !running;
+    return running;
 }
 
-std::string Json::JParser::stripZero(const float &f) {
-    auto s = std::to_string(f);
-    s.erase(s.find_last_not_of('0') + 1, std::string::npos);
-    if (s.back() == '.') s.pop_back();
-    return s;
+void Json::JStreamParser::finish() {
+    if (!_stopped) {
+        if (_lexer == Lexer::String || _lexer == Lexer::Escape) {
+            throw JException::ParseJsonError("The character '\"' is not enclosed" + where(_token_begin) + "!");
+        }
+        if (_lexer == Lexer::Scalar) {
+            _lexer = Lexer::Structure;
+            flushScalar();
+        }
+        if (!_stack.empty()) uncompleted();
+    }
+    size_t documents = _documents;
+    reset();
+    _documents = documents;
 }
 
-std::string Json::JParser::stripZero(const double &d) {
-    auto s = std::to_string(d);
-    s.erase(s.find_last_not_of('0') + 1, std::string::npos);
-    if (s.back() == '.') s.pop_back();
-    return s;
+void Json::JStreamParser::reset() {
+    _stack.clear();
+    _token.clear();
+    _expect = Expect::Document;
+    _lexer = Lexer::Structure;
+    _stopped = false;
+    _documents = 0;
+    _offset = _line_begin = 0;
+    _line = 1;
 }
 
-const Json::JObject & Json::JParser::object() const {
-    return _root_object;
+bool Json::JStreamParser::complete() const {
+    return _expect == Expect::Document;
 }
 
-const Json::JArray & Json::JParser::array() const {
-    return _root_array;
+size_t Json::JStreamParser::documents() const {
+    return _documents;
 }
 
-void Json::JParser::setRootObject(Json::JObject root_object) {
-    _root_object = std::move(root_object);
-    _root_array.clear();
+Json::JStreamParser::Mark Json::JStreamParser::mark() const {
+    return {_line, _offset + _pos - _line_begin + 1};
 }
 
-void Json::JParser::setRootArray(Json::JArray root_array) {
-    _root_array = std::move(root_array);
-    _root_object.clear();
+std::string Json::JStreamParser::where(const Mark &mark) {
+    return " at line " + std::to_string(mark.line) + " col " + std::to_string(mark.col);
 }
 
-std::vector<Json::JParser::Token> Json::JParser::extract(const std::string &json, uint32_t &line, uint32_t &col) {
-    std::vector<Token> tokens;
-    bool check_begin = true;
-    uint32_t enclosed_1 = 0, enclosed_2 = 0;
-    size_t end_pos = 0;
-    bool flag_end_pos = false;
-    Token temp_token_1, temp_token_2;
-    for (size_t i = 0; i < json.size();) {
-        char c = json[i];
-        if (c == ' ') {
-            col++; i++;
-        } else if (c == '\n' || c == '\t') {
-            line++; col = 1; i++;
-        } else if (c == '{' || c == '}' || c == '[' || c == ']' || c == ',' || c == ':') {
-            tokens.emplace_back(std::string(1, c), "", line, col);
-            if (c == '{') enclosed_1++;
-            if (c == '}') {
-                enclosed_1--;
-                if (!enclosed_1 && !flag_end_pos && tokens.front().type == "{") {
-                    end_pos = tokens.size() - 1;
-                    flag_end_pos = true;
-                }
+bool Json::JStreamParser::structure(char c) {
+    switch (c) {
+        case '{':
+        case '[':
+            if (_expect != Expect::Document && _expect != Expect::Value && _expect != Expect::ValueOrEnd) {
+                unexpected(std::string(1, c));
             }
-            if (c == '[') enclosed_2++;
-            if (c == ']') {
-                enclosed_2--;
-                if (!enclosed_2 && !flag_end_pos && tokens.front().type == "[") {
-                    end_pos = tokens.size() - 1;
-                    flag_end_pos = true;
-                }
+            _stack.push_back({c, mark()});
+            _pos++;
+            if (c == '{') {
+                _expect = Expect::KeyOrEnd;
+                return _handler.onStartObject();
             }
-            i++; col++;
-        } else if (c == '"') {
-            tokens.emplace_back(extractString(json, i, line, col));
-        } else if (isdigit(c) || c == '-') {
-            tokens.emplace_back(extractNumber(json, i, line, col));
-        } else if (c == 't') {
-            auto key = json.substr(i, 4);
-            if (key != "true") {
-                throw JException::ParseJsonError("Unexpected keyword \"" +
-                                     key + "\" at line " + std::to_string(line) +
-                                     " col " + std::to_string(col) + "!");
+            _expect = Expect::ValueOrEnd;
+            return _handler.onStartArray();
+        case '}':
+        case ']': {
+            bool is_object = (c == '}');
+            bool is_open = !_stack.empty() && _stack.back().kind == (is_object ? '{' : '[');
+            if (is_open && (_expect == Expect::CommaOrEnd ||
+                            _expect == (is_object ? Expect::KeyOrEnd : Expect::ValueOrEnd))) {
+                _stack.pop_back();
+                _pos++;
+                if (!(is_object ? _handler.onEndObject() : _handler.onEndArray())) return false;
+                return afterValue();
             }
-            tokens.emplace_back("bool", "true", line, col);
-            i += 4; col += 4;
-        } else if (c == 'f') {
-            auto key = json.substr(i, 5);
-            if (key != "false") {
-                throw JException::ParseJsonError("Unexpected keyword \"" +
-                                     key + "\" at line " + std::to_string(line) +
-                                     " col " + std::to_string(col) + "!");
+            if (is_open && _expect == (is_object ? Expect::Key : Expect::Value)) {
+                throw JException::ParseJsonError(std::string(is_object ? "The Object" : "The Array") +
+                                                 " is not completed" + where(_comma) + "!");
+            }
+            unexpected(std::string(1, c));
+        }
+        case ',':
+            if (_expect != Expect::CommaOrEnd) unexpected(",");
+            _comma = mark();
+            _pos++;
+            _expect = (_stack.back().kind == '{') ? Expect::Key : Expect::Value;
+            return true;
+        case ':':
+            if (_expect == Expect::CommaOrEnd && _stack.back().kind == '[') {
+                throw JException::ParseJsonError("Unexpected character ':' in array" + where(mark()) + "!");
             }
-            tokens.emplace_back("bool", "false", line, col);
-            i += 5; col += 5;
-        } else if (c == 'n') {
-            auto key = json.substr(i, 4);
-            if (key != "null") {
-                throw JException::ParseJsonError("Unexpected keyword \"" +
-                                     key + "\" at line " + std::to_string(line) +
-                                     " col " + std::to_string(col) + "!");
+            if (_expect != Expect::Colon) unexpected(":");
+            _pos++;
+            _expect = Expect::Value;
+            return true;
+        case '"':
+            if (_expect == Expect::Key || _expect == Expect::KeyOrEnd) {
+                _is_key = true;
+            } else if (_expect == Expect::Value || _expect == Expect::ValueOrEnd) {
+                _is_key = false;
+            } else {
+                unexpected("string");
             }
-            tokens.emplace_back("null", "", line, col);
-            i += 4; col += 4;
-        } else {
-            throw JException::ParseJsonError("Unexpected character '" +
-                                 std::string(1, c) + "' at line " + std::to_string(line) +
-                                 " col " + std::to_string(col) + "!");
-        }
-        if (check_begin && !tokens.empty()) {
-            bool b = (tokens.front().type == "{" || tokens.front().type == "[");
-            if (!b) {
-                throw JException::ParseJsonError("The JSON text does not start with '{' or '['!");
+            _token_begin = mark();
+            _token.clear();
+            _has_escape = false;
+            _lexer = Lexer::String;
+            _pos++;
+            return true;
+        default: {
+            std::string name;
+            if (c == 't' || c == 'f') {
+                name = "bool";
+            } else if (c == 'n') {
+                name = "null";
+            } else if (c == '-' || isdigit(static_cast<unsigned char>(c))) {
+                name = "number";
+            } else {
+                throw JException::ParseJsonError("Unexpected character '" + std::string(1, c) + "'" +
+                                                 where(mark()) + "!");
             }
-            check_begin = false;
+            if (_expect != Expect::Value && _expect != Expect::ValueOrEnd) unexpected(name);
+            _token_begin = mark();
+            _token.clear();
+            _lexer = Lexer::Scalar;
+            return true;
         }
     }
-    if (enclosed_2) {
-        throw JException::ParseJsonError("Redundant enclosing character '" + temp_token_2.type + "' at line " +
-                             std::to_string(temp_token_2.line) + " col " +
-                             std::to_string(temp_token_2.col) + "!");
-    }
-    if (enclosed_1) {
-        throw JException::ParseJsonError("Redundant enclosing character '" + temp_token_1.type + "' at line " +
-                             std::to_string(temp_token_1.line) + " col " +
-                             std::to_string(temp_token_1.col) + "!");
-    }
-    if (end_pos < tokens.size() - 1) {
-        throw JException::ParseJsonError("Redundant enclosing character '" + tokens[end_pos + 1].type + "' at line " +
-                             std::to_string(tokens[end_pos + 1].line) + " col " +
-                             std::to_string(tokens[end_pos + 1].col) + "!");
-    }
-    return tokens;
 }
 
-Json::JParser::Token Json::JParser::extractString(const std::string &json, size_t &pos,
-                                                  uint32_t &line, uint32_t &col) {
-    size_t start_pos = ++pos, end_pos = 0;
-    size_t begin_line = line, begin_col = ++col;
-    auto _size = json.size();
-    while (pos < _size) {
-        auto ch = json[pos++];
-        col++;
-        if (ch == '"') {
-            end_pos = pos - 1;
-            return {"string", json.substr(start_pos, end_pos - start_pos), begin_line, begin_col};
-        } else if (ch == '\n') {
-            throw JException::ParseJsonError("The character '\\n' is not supported at line " +
-                                    std::to_string(line) + " col " + std::to_string(col) + "!");
-        }
-    }
-    throw JException::ParseJsonError("The character '\"' is not enclosed at line " + std::to_string(begin_line) +
-                         " col " + std::to_string(begin_col - 1) + "!");
-}
-
-Json::JParser::Token Json::JParser::extractNumber(const std::string &json, size_t &pos,
-                                                  uint32_t &line, uint32_t &col) {
-    size_t start_pos = pos, end_pos = 0;
-    size_t begin_line = line, begin_col = col;
-    auto _size = json.size();
-    bool is_minus = false, is_point = false;
-    if (json[pos] == '0' && isdigit(json[pos + 1])) {
-        throw JException::ParseJsonError("The number can not start with the digit '0' at line " + std::to_string(line) +
-                             " col " + std::to_string(col - 1) + "!");
-    }
-    while (pos < _size) {
-        auto ch = json[pos++];
-        col++;
-        if (ch == '-') {
-            if (is_minus) {
-                throw JException::ParseJsonError("The number is not allowed to have repeated '-' characters at line " + std::to_string(line) +
-                                     " col " + std::to_string(col - 1) + "!");
+bool Json::JStreamParser::scanString() {
+    size_t begin = _pos;
+    while (_pos < _size) {
+        if (_lexer == Lexer::Escape) {
+            _lexer = Lexer::String;
+            if (_data[_pos] != '\n') _pos++;
+            continue;
+        }
+        _pos = findStringSpecial(_data, _pos, _size);
+        if (_pos >= _size) break;
+        char c = _data[_pos];
+        if (c == '"') {
+            std::string_view text(_data + begin, _pos - begin);
+            /// 字符串跨越了输入块时才需要拼接
+            if (!_token.empty()) {
+                _token.append(text);
+                text = _token;
             }
-            else is_minus = true;
-        } else if (ch == '.') {
-            if (is_point) {
-                throw JException::ParseJsonError("The number is not allowed to have repeated '.' characters at line " + std::to_string(line) +
-                                     " col " + std::to_string(col - 1) + "!");
-            } else {
-                is_point = true;
+            _pos++;
+            _lexer = Lexer::Structure;
+            if (_has_escape) {
+                _unescaped.clear();
+                size_t error = unescapeInto(text, _unescaped);
+                if (error != std::string_view::npos) {
+                    throw JException::ParseJsonError("The unicode escape sequence is invalid" +
+                                                     where({_token_begin.line, _token_begin.col + 1 + error}) + "!");
+                }
+                text = _unescaped;
             }
-        } else if (!isdigit(ch)) {
-            col--;
-            end_pos = --pos;
-            break;
+            if (_is_key) {
+                _expect = Expect::Colon;
+                return _handler.onKey(text);
+            }
+            return _handler.onString(text) && afterValue();
+        } else if (c == '\\') {
+            _lexer = Lexer::Escape;
+            _has_escape = true;
+        } else {
+            throw JException::ParseJsonError("The character '\\n' is not supported" + where(mark()) + "!");
         }
+        _pos++;
     }
-    auto cnt = end_pos - start_pos;
-    if (cnt <= 0) {
-        throw JException::ParseJsonError("The JSON context does not end with '}'!");
-    }
-    return {"number", json.substr(start_pos, cnt), begin_line, begin_col};
+    _token.append(_data + begin, _pos - begin);
+    return true;
 }
 
-bool Json::JParser::hasLastOfType(const std::vector<Token> &tokens, const std::string &type,
-                                  const std::string &ends_with_type) {
-    size_t _size = tokens.size();
-    while (--_size) {
-        if (tokens[_size].type == type) return true;
-        if (!ends_with_type.empty() && tokens[_size].type == ends_with_type) return false;
+bool Json::JStreamParser::scanScalar() {
+    size_t begin = _pos;
+    for (; _pos < _size; ++_pos) {
+        char c = _data[_pos];
+        if (c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == ',' || c == ':' ||
+            c == '{' || c == '}' || c == '[' || c == ']' || c == '"') {
+            _token.append(_data + begin, _pos - begin);
+            _lexer = Lexer::Structure;
+            return flushScalar();
+        }
     }
-    return false;
+    _token.append(_data + begin, _pos - begin);
+    return true;
 }
 
-Json::JObject Json::JParser::parseObject(const std::vector<Token> &tokens, size_t &pos) {
-    Json::JObject result;
-    auto line = tokens[pos].line, col = tokens[pos].col;
-    if (tokens[pos].type != "{") {
-        throw JException::ParseJsonError("The Object is not start with \'{\' at line " +
-                             std::to_string(tokens[pos].line) + " col " +
-                             std::to_string(tokens[pos].col) + "!");
-    }
-    pos += 1;
-    while (pos < tokens.size()) {
-        std::string key;
-        if (tokens[pos].type == "}") {
-            if (tokens[pos - 1].type == ",")
-                throw JException::ParseJsonError("The Object is not completed at line " +
-                                 std::to_string(tokens[pos - 1].line) + " col " +
-                                 std::to_string(tokens[pos - 1].col) + "!");
-            else
-                return result;
-        }
-
-        if (tokens[pos].type != "string") {
-            throw JException::ParseJsonError("Expected '" + tokens[pos].type + "' at line " +
-                                 std::to_string(tokens[pos].line) + " col " +
-                                 std::to_string(tokens[pos].col) + "! Next one should be the key name!");
-        }
-        key = tokens[pos].value;
-        pos++;
-        if (tokens[pos].type != ":") {
-            throw JException::ParseJsonError("Expected '" + tokens[pos].type + "' at line " +
-                                 std::to_string(tokens[pos].line) + " col " +
-                                 std::to_string(tokens[pos].col) + "! Next one should be the ':'!");
-        }
-        pos++;
-        if (tokens[pos].type == "[") {
-            result.set(key, std::make_shared<JArray>(parseArray(tokens, pos)));
-        } else if (tokens[pos].type == "{") {
-            result.set(key, std::make_shared<JObject>(parseObject(tokens, pos)));
-        } else {
-            result.set(key, parseValue(tokens[pos]));
+bool Json::JStreamParser::flushScalar() {
+    auto at = [this](size_t i) {
+        return where({_token_begin.line, _token_begin.col + i});
+    };
+    for (std::string_view keyword : {"true", "false", "null"}) {
+        if (_token[0] != keyword[0]) continue;
+        if (_token.compare(0, keyword.size(), keyword) != 0) {
+            throw JException::ParseJsonError("Unexpected keyword \"" + _token + "\"" + at(0) + "!");
         }
-        pos++;
-        if (tokens[pos].type == "}") {
-            return result;
-        } else if (tokens[pos].type == ",") {
-            pos++;
-            continue;
+        if (_token.size() > keyword.size()) {
+            throw JException::ParseJsonError("Unexpected character '" + std::string(1, _token[keyword.size()]) +
+                                             "'" + at(keyword.size()) + "!");
         }
+        bool running = (keyword == "null") ? _handler.onNull() : _handler.onBool(keyword == "true");
+        return running && afterValue();
+    }
+    Number number = parseNumberText(_token);
+    if (number.error != NumberError::None) {
+        throw JException::ParseJsonError(numberError(number, _token) + at(number.error_at) + "!");
     }
-    throw JException::ParseJsonError("There is still an uncompleted object from the character '{' at line " +
-                         std::to_string(line) + " col " + std::to_string(col) + "!");
+    if (number.length < _token.size()) {
+        throw JException::ParseJsonError("Unexpected character '" + std::string(1, _token[number.length]) + "'" +
+                                         at(number.length) + "!");
+    }
+    bool running = number.is_integer ? _handler.onInt64(number.integer) : _handler.onDouble(number.real);
+    return running && afterValue();
 }
 
-Json::JValue Json::JParser::parseValue(const Json::JParser::Token &token) {
-    if (token.type == "string") {
-        auto s = strToEscape(token.value);
-        return s;
-    } else if (token.type == "number") {
-        if (token.value.find('.') != std::string::npos) {
-            return std::stod(token.value);
-        } else {
-            return std::stoll(token.value);
-        }
-    } else if (token.type == "bool") {
-        if (token.value == "true") {
-            return true;
-        } else if (token.value == "false") {
-            return false;
-        }
-    } else if (token.type == "null") {
-        return std::monostate{};
-    } else if (token.type == "[") {
-        return std::monostate{};
-    } else if (token.type == "{") {
-        return std::monostate{};
-    } else {
-        throw JException::ParseJsonError("Can't parse value type '" + token.type + "' at line " +
-                             std::to_string(token.line) + " col " +
-                             std::to_string(token.col) + "!");
+bool Json::JStreamParser::afterValue() {
+    if (!_stack.empty()) {
+        _expect = Expect::CommaOrEnd;
+        return true;
     }
-    return std::monostate{};
+    _expect = Expect::Document;
+    _documents++;
+    return _handler.onEndDocument();
 }
 
-Json::JArray Json::JParser::parseArray(const std::vector<Token> &tokens, size_t &pos) {
-    Json::JArray result;
-    auto line = tokens[pos].line, col = tokens[pos].col;
-    if (tokens[pos].type != "[") {
-        throw JException::ParseJsonError("The Array is not start with \'{\' at line " +
-                             std::to_string(tokens[pos].line) + " col " +
-                             std::to_string(tokens[pos].col) + "!");
+void Json::JStreamParser::unexpected(const std::string &name) const {
+    switch (_expect) {
+        case Expect::Document:
+            throw JException::ParseJsonError("The JSON text does not start with '{' or '['!");
+        case Expect::Value:
+        case Expect::ValueOrEnd:
+            throw JException::ParseJsonError("Can't parse value type '" + name + "'" + where(mark()) + "!");
+        case Expect::Key:
+        case Expect::KeyOrEnd:
+            throw JException::ParseJsonError("Expected '" + name + "'" + where(mark()) +
+                                             "! Next one should be the key name!");
+        case Expect::Colon:
+            throw JException::ParseJsonError("Expected '" + name + "'" + where(mark()) +
+                                             "! Next one should be the ':'!");
+        default:
+            uncompleted();
     }
-    pos++;
-    while (pos < tokens.size()) {
-        std::string key;
-        if (tokens[pos].type == "]" && tokens[pos - 1].type == ",") {
-            throw JException::ParseJsonError("The Array is not completed at line " +
-                                 std::to_string(tokens[pos - 1].line) + " col " +
-                                 std::to_string(tokens[pos - 1].col) + "!");
-        }
-        if (tokens[pos].type == "[") {
-            result.append(std::make_shared<JArray>(parseArray(tokens, pos)));
-        } else if (tokens[pos].type == "{") {
-            result.append(std::make_shared<JObject>(parseObject(tokens, pos)));
-        } else if (tokens[pos].type == "]") {
-            return result;
-        } else {
-            result.append(parseValue(tokens[pos]));
+}
+
+void Json::JStreamParser::uncompleted() const {
+    const Scope &scope = _stack.back();
+    if (scope.kind == '{') {
+        throw JException::ParseJsonError("There is still an uncompleted object from the character '{'" +
+                                         where(scope.begin) + "!");
+    }
+    throw JException::ParseJsonError("There is still an uncompleted array from the character '['" +
+                                     where(scope.begin) + "!");
+}
+
+Json::JLinesParser::JLinesParser(size_t threads)
+    : _threads(threads ? threads : WorkerPool::defaultThreads()) {}
+
+void Json::JLinesParser::parse(std::string_view text, const std::function<void(JLine&)> &callback) const {
+    /// 每批为约 64 KiB 的完整行；每轮最多解析线程数 8 倍的批次，限制有序交付时缓存的结果数量
+    constexpr size_t BATCH_BYTES = 64 * 1024;
+    struct Batch {
+        std::string_view text;
+        size_t first_line;
+        std::vector<JLine> lines;
+    };
+    std::mutex delivery;
+    size_t pos = 0, line = 1;
+    while (pos < text.size()) {
+        std::vector<Batch> batches;
+        while (batches.size() < _threads * 8 && pos < text.size()) {
+            size_t end = std::min(pos + BATCH_BYTES, text.size());
+            if (end < text.size()) {
+                end = text.find('\n', end);
+                end = (end == std::string_view::npos) ? text.size() : end + 1;
+            }
+            std::string_view piece = text.substr(pos, end - pos);
+            batches.push_back({piece, line, {}});
+            line += std::count(piece.begin(), piece.end(), '\n');
+            pos = end;
         }
-        pos++;
-        if (tokens[pos].type == "]") {
-            return result;
-        } else if (tokens[pos].type == ",") {
-            pos++;
-            continue;
-        } else if (tokens[pos].type == ":") {
-            throw JException::ParseJsonError("Unexpected character ':' in array at line " +
-                                 std::to_string(tokens[pos].line) + " col " +
-                                 std::to_string(tokens[pos].col) + "!");
-        } else {
-            throw JException::ParseJsonError("There is still an uncompleted array from the character '[' at line " +
-                                 std::to_string(line) + " col " + std::to_string(col) + "!");
+        WorkerPool::instance().run(batches.size(), _threads, [&](size_t index) {
+            Batch &batch = batches[index];
+            size_t number = batch.first_line;
+            for (size_t begin = 0; begin < batch.text.size(); ++number) {
+                size_t end = batch.text.find('\n', begin);
+                if (end == std::string_view::npos) end = batch.text.size();
+                std::string_view content = batch.text.substr(begin, end - begin);
+                begin = end + 1;
+                if (content.find_first_not_of(" \t\r") == std::string_view::npos) continue;
+                JLine &result = batch.lines.emplace_back();
+                result.number = number;
+                try {
+                    result.document.load(content);
+                } catch (const JException::ParseJsonError &e) {
+                    result.error = e.what();
+                }
+            }
+            if (!_ordered) {
+                std::lock_guard<std::mutex> lock(delivery);
+                for (auto &result : batch.lines) callback(result);
+                batch.lines.clear();
+            }
+        });
+        if (_ordered) {
+            for (auto &batch : batches) {
+                for (auto &result : batch.lines) callback(result);
+            }
         }
     }
-    throw JException::ParseJsonError("There is still an uncompleted array from the character '[' at line " +
-                         std::to_string(line) + " col " + std::to_string(col) + "!");
+}
+
+std::vector<Json::JLine> Json::JLinesParser::parse(std::string_view text) const {
+    std::vector<JLine> lines;
+    parse(text, [&lines](JLine &line) { lines.push_back(std::move(line)); });
+    if (!_ordered) {
+        std::sort(lines.begin(), lines.end(), [](const JLine &a, const JLine &b) { return a.number < b.number; });
+    }
+    return lines;
+}
+
+bool Json::JLinesParser::parseFromFile(const std::string &file_name,
+                                       const std::function<void(JLine&)> &callback) const {
+    MappedFile file(file_name);
+    if (!file.isOpen()) return false;
+    parse(file.view(), callback);
+    return true;
+}
+
+void Json::JLinesParser::setOrdered(bool ordered) {
+    _ordered = ordered;
+}
+
+bool Json::JLinesParser::ordered() const {
+    return _ordered;
+}
+
+size_t Json::JLinesParser::threads() const {
+    return _threads;
 }
 
 std::string Json::escToString(const std::string &str) {
     std::string result;
-    size_t pos = 0;
-    while (pos < str.size()) {
-        if (str[pos] == '\\') {
-            result += "\\\\";
-        } else if (str[pos] == '\t') {
-            result += "\\t";
-        } else if (str[pos] == '\r') {
-            result += "\\r";
-        } else if (str[pos] == '\n') {
-            result += "\\n";
-        } else if (str[pos] == '\f') {
-            result += "\\f";
-        } else if (str[pos] == '\b') {
-            result += "\\b";
-        } else if (str[pos] == '"') {
-            result += "\\\"";
-        } else if (str[pos] == '\'') {
-            result += "\\'";
-        } else {
-            result += str[pos];
-        }
-        pos++;
-    }
+    escapeInto(str, result);
     return result;
 }
 
 std::string Json::strToEscape(const std::string &str) {
-    std::string result, s = str;
-    size_t pos = 0;
-    while (pos < str.size()) {
-        if (s[pos++] == '\\') {
-            if (s[pos] == '\\' ) {
-                result += "\\";
-            } else if (s[pos] == 't') {
-                result += '\t';
-            } else if (s[pos] == 'r') {
-                result += '\r';
-            } else if (s[pos] == 'n') {
-                result += '\n';
-            } else if (s[pos] == 'f') {
-                result += '\f';
-            } else if (s[pos] == 'b') {
-                result += '\b';
-            } else if (s[pos] == '"') {
-                result += '"';
-            } else if (s[pos] == '\'') {
-                result += '\'';
-            }
-            pos++;
-        } else {
-            result += s[pos - 1];
-        }
-    }
+    std::string result;
+    unescapeInto(str, result);
     return result;
 }
 
@@ -1033,4 +4398,72 @@ bool Json::JGet::isObject(const Json::JValue &value) {
     return std::holds_alternative<std::shared_ptr<JArray>>(value);
 }
 
+bool Json::JGet::toBool(const Json::JNode &node) {
+    if (node._type == Bool) return node._value.boolean;
+    throw JException::GetBadValueException("The specified value can not convert to boolean!");
+}
+
+int32_t Json::JGet::toInt(const Json::JNode &node) {
+    if (node._type == Int || node._type == BigInt) return static_cast<int32_t>(node._value.integer);
+    throw JException::GetBadValueException("The specified value can not convert to integer!");
+}
+
+int64_t Json::JGet::toBigInt(const Json::JNode &node) {
+    if (node._type == Int || node._type == BigInt) return node._value.integer;
+    throw JException::GetBadValueException("The specified value can not convert to big integer!");
+}
+
+float Json::JGet::toFloat(const Json::JNode &node) {
+    if (node._type == Float) return node._value.real32;
+    if (node._type == Double) return static_cast<float>(node._value.real);
+    throw JException::GetBadValueException("The specified value can not convert to float!");
+}
+
+double Json::JGet::toDouble(const Json::JNode &node) {
+    if (node._type == Float) return static_cast<double>(node._value.real32);
+    if (node._type == Double) return node._value.real;
+    throw JException::GetBadValueException("The specified value can not convert to double!");
+}
+
+std::string_view Json::JGet::toString(const Json::JNode &node) {
+    if (node._type == String) return node.text();
+    throw JException::GetBadValueException("The specified value can not convert to string!");
+}
+
+bool Json::JGet::isNull(const Json::JNode &node) {
+    return node._type == Null;
+}
+
+bool Json::JGet::isBool(const Json::JNode &node) {
+    return node._type == Bool;
+}
+
+bool Json::JGet::isInt(const Json::JNode &node) {
+    return node._type == Int;
+}
+
+bool Json::JGet::isBigInt(const Json::JNode &node) {
+    return node._type == BigInt;
+}
+
+bool Json::JGet::isFloat(const Json::JNode &node) {
+    return node._type == Float;
+}
+
+bool Json::JGet::isDouble(const Json::JNode &node) {
+    return node._type == Double;
+}
+
+bool Json::JGet::isString(const Json::JNode &node) {
+    return node._type == String;
+}
+
+bool Json::JGet::isArray(const Json::JNode &node) {
+    return node._type == Array;
+}
+
+bool Json::JGet::isObject(const Json::JNode &node) {
+    return node._type == Object;
+}
+
 
@@ -21,6 +21,11 @@
 #include <fstream>
 #include <stdexcept>
 #include <memory>
+#include <string_view>
+#include <span>
+#include <iterator>
+#include <atomic>
+#include <memory_resource>
 
 namespace Json {
     namespace JException {
@@ -75,6 +80,7 @@ namespace Json {
 
     class JObject;
     class JArray;
+    class JWriter;
     using JValue = std::variant<
         std::monostate,
         bool,
@@ -86,11 +92,101 @@ namespace Json {
         std::shared_ptr<JArray>,
         std::shared_ptr<JObject>
     >;
+
+    namespace Internal {
+        /// 写时复制的连续数组（供 JObject、JArray 内部使用）：引用计数、长度与元素位于同一块内存中，
+        /// 复制只增加引用计数；非 const 成员在内存块被共享时先复制一份，之后返回的指针只属于本副本
+        template<typename T>
+        class SharedVector {
+        public:
+            using value_type = T;
+            using iterator = T *;
+            using const_iterator = const T *;
+
+            SharedVector() noexcept = default;
+            SharedVector(const SharedVector &other) noexcept;
+            SharedVector(SharedVector &&other) noexcept;
+            SharedVector &operator=(SharedVector other) noexcept;
+            ~SharedVector();
+
+            [[nodiscard]] size_t size() const noexcept { return _block ? _block->size : 0; }
+            [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+            [[nodiscard]] const T *begin() const noexcept { return data(); }
+            [[nodiscard]] const T *end() const noexcept { return data() + size(); }
+            [[nodiscard]] const T &operator[](size_t index) const { return data()[index]; }
+            [[nodiscard]] const T &at(size_t index) const;
+            [[nodiscard]] const T &back() const { return data()[size() - 1]; }
+            T *begin();
+            T *end();
+            T &operator[](size_t index);
+            T &at(size_t index);
+            T &back();
+
+            void reserve(size_t capacity);
+            /// 替换为 count 个 value
+            void assign(size_t count, const T &value);
+            /// value 先按值传入再扩容，因此可以引用本数组中的元素
+            T &push_back(T value);
+            T *insert(const T *position, T value);
+            T *erase(const T *position);
+            void pop_back();
+            /// 释放本副本的引用，不保留容量
+            void clear() noexcept;
+        private:
+            struct Block {
+                std::atomic<size_t> references;
+                size_t size;
+                size_t capacity;
+            };
+
+            [[nodiscard]] T *data() const noexcept { return _block ? reinterpret_cast<T *>(_block + 1) : nullptr; }
+            void detach();
+            /// 换成容量为 capacity 的独占内存块：独占时移动元素，共享时复制元素
+            void reallocate(size_t capacity);
+            static void release(Block *block) noexcept;
+
+            Block *_block{nullptr};
+        };
+    }
+
     class JObject {
     public:
         explicit JObject();
-        using constIterator = std::unordered_map<std::string, JValue>::const_iterator;
-        using iterator = std::unordered_map<std::string, JValue>::iterator;
+        /// 按插入顺序遍历
+        using constIterator = const std::pair<std::string, JValue> *;
+        /// 可写迭代器只能修改值：解引用得到 std::pair<const std::string &, JValue &>，键名改动会使哈希索引失效
+        class iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = std::pair<std::string, JValue>;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::pair<const std::string &, JValue &>;
+            struct pointer {
+                reference member;
+                const reference *operator->() const { return &member; }
+            };
+
+            iterator() = default;
+            reference operator*() const { return {_it->first, _it->second}; }
+            pointer operator->() const { return {**this}; }
+            iterator &operator++() {
+                ++_it;
+                return *this;
+            }
+            iterator operator++(int) { return iterator(_it++); }
+            iterator &operator--() {
+                --_it;
+                return *this;
+            }
+            iterator operator--(int) { return iterator(_it--); }
+            bool operator==(const iterator &other) const = default;
+            operator constIterator() const { return _it; }
+        private:
+            friend class JObject;
+            using Base = std::pair<std::string, JValue> *;
+            explicit iterator(Base it) : _it(it) {}
+            Base _it;
+        };
 
         [[nodiscard]] constIterator begin() const;
         [[nodiscard]] constIterator end() const;
@@ -98,38 +194,119 @@ namespace Json {
         [[nodiscard]] iterator end();
         [[nodiscard]] size_t size() const;
 
-        void set(const std::string &key, const JValue &value = std::monostate{});
-        void set(const std::string &key, const JArray &array);
-        void set(const std::string &key, const JObject &object);
-        JValue & get(const std::string &key);
-        bool valid(const std::string &key);
-        void remove(const std::string &key);
+        void set(std::string_view key, const JValue &value = std::monostate{});
+        void set(std::string_view key, const JArray &array);
+        void set(std::string_view key, const JObject &object);
+        /// 右值版本直接移动；传入 std::shared_ptr<JArray/JObject> 时共享该子节点而不复制
+        void set(std::string_view key, JValue &&value);
+        void set(std::string_view key, JArray &&array);
+        void set(std::string_view key, JObject &&object);
+        /// 将键设为新的空容器并返回其引用，用于原位构建子节点；引用在复制本对象后失效
+        JArray & emplaceArray(std::string_view key);
+        JObject & emplaceObject(std::string_view key);
+        JValue & get(std::string_view key);
+        bool valid(std::string_view key) const;
+        void remove(std::string_view key);
         void clear();
 
-        bool toBool(const std::string &key) const;
-        int32_t toInt(const std::string &key) const;
-        int64_t toBigInt(const std::string &key) const;
-        float toFloat(const std::string &key) const;
-        double toDouble(const std::string &key) const;
-        const std::string & toString(const std::string &key) const;
-        const JArray* toArray(const std::string &key) const;
-        const JObject* toObject(const std::string &key) const;
+        bool toBool(std::string_view key) const;
+        int32_t toInt(std::string_view key) const;
+        int64_t toBigInt(std::string_view key) const;
+        float toFloat(std::string_view key) const;
+        double toDouble(std::string_view key) const;
+        const std::string & toString(std::string_view key) const;
+        const JArray* toArray(std::string_view key) const;
+        const JObject* toObject(std::string_view key) const;
 
         std::vector<std::string> keys() const;
-        bool isNull(const std::string &key) const;
+        bool isNull(std::string_view key) const;
 
-        JValue & operator[](const std::string &key);
+        JValue & operator[](std::string_view key);
     private:
-        std::unordered_map<std::string, JValue> _dict;
+        friend class JParser;
+        friend class JNode;
+        /// 键值对按插入顺序连续存放；键数超过 INDEX_THRESHOLD 时另建开放寻址哈希索引（存放下标），否则顺序比较
+        class Storage {
+        public:
+            [[nodiscard]] constIterator begin() const { return _entries.begin(); }
+            [[nodiscard]] constIterator end() const { return _entries.end(); }
+            [[nodiscard]] iterator begin() { return iterator(_entries.begin()); }
+            [[nodiscard]] iterator end() { return iterator(_entries.end()); }
+            [[nodiscard]] size_t size() const { return _entries.size(); }
+            [[nodiscard]] bool empty() const { return _entries.empty(); }
+
+            [[nodiscard]] bool contains(std::string_view key) const;
+            /// 键不存在时返回 nullptr
+            [[nodiscard]] const JValue *find(std::string_view key) const;
+            [[nodiscard]] JValue *find(std::string_view key);
+            JValue &operator[](std::string_view key);
+            /// 返回键对应的值
+            JValue &insert_or_assign(std::string key, JValue value);
+            /// 值先复制再插入，value 可以引用本对象中的元素
+            void assign(std::string_view key, JValue value);
+            size_t erase(std::string_view key);
+            void reserve(size_t capacity);
+            void clear();
+        private:
+            static constexpr size_t INDEX_THRESHOLD = 16;
+            static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+            [[nodiscard]] size_t position(std::string_view key) const;
+            JValue &append(std::string &&key, JValue &&value);
+            void addToIndex(size_t position);
+            void rebuildIndex();
+
+            Internal::SharedVector<std::pair<std::string, JValue>> _entries;
+            Internal::SharedVector<uint32_t> _index;
+        };
+        /// 只查找一次，键不存在时抛出 KeyIsNotFoundException
+        const JValue &lookup(std::string_view key) const;
+        [[nodiscard]] const Storage &read() const;
+        Storage &write();
+        /// 写时复制：副本之间共享存储，修改前若存储被共享则先复制。复制容器会使此前经 emplaceArray / emplaceObject、
+        /// get、operator[] 或可写迭代器取得的引用、指针与迭代器失效：之后通过它们写入可能同时改变副本，须在复制后重新取得
+        Storage _dict;
     };
 
     class JArray {
     public:
-        using constIterator = std::vector<JValue>::const_iterator;
-        using iterator = std::vector<JValue>::iterator;
+        /// 只读迭代器：普通存储直接返回元素的引用；紧凑存储的元素在解引用时逐个生成，
+        /// 返回的引用指向迭代器内部，只在迭代器移动之前有效
+        class constIterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = JValue;
+            using difference_type = std::ptrdiff_t;
+            using reference = const JValue &;
+            using pointer = const JValue *;
+
+            constIterator() = default;
+            reference operator*() const { return _values ? _values[_index] : unpacked(); }
+            pointer operator->() const { return &**this; }
+            constIterator &operator++() {
+                ++_index;
+                return *this;
+            }
+            constIterator operator++(int) {
+                constIterator previous = *this;
+                ++_index;
+                return previous;
+            }
+            bool operator==(const constIterator &other) const { return _index == other._index; }
+        private:
+            friend class JArray;
+            [[nodiscard]] const JValue &unpacked() const;
+
+            const JValue *_values{nullptr};
+            const int64_t *_integers{nullptr};
+            const double *_reals{nullptr};
+            size_t _index{0};
+            mutable JValue _current;
+        };
+        using iterator = JValue *;
 
         explicit JArray();
-        explicit JArray(const std::vector<JValue>&& values);
+        explicit JArray(std::vector<JValue>&& values);
 
         [[nodiscard]] constIterator begin() const;
         [[nodiscard]] constIterator end() const;
@@ -137,6 +314,8 @@ namespace Json {
         [[nodiscard]] iterator end();
         [[nodiscard]] size_t size() const;
         [[nodiscard]] size_t length() const;
+        /// 紧凑存储的数组第一次调用时展开全部元素（每个元素一个 JValue）并一直缓存；
+        /// 逐个读取请使用 toInt 等访问函数或 const 迭代，它们不会展开
         [[nodiscard]] const JValue& get(size_t index) const;
         [[nodiscard]] bool isNull(size_t index) const;
 
@@ -161,6 +340,22 @@ namespace Json {
         void insert(size_t index, const JValue& value);
         void insert(size_t index, const JArray& value);
         void insert(size_t index, const JObject& value);
+        /// 右值版本直接移动；传入 std::shared_ptr<JArray/JObject> 时共享该子节点而不复制
+        void pushBack(JValue&& value);
+        void pushBack(JArray&& array);
+        void pushBack(JObject&& object);
+        void pushFront(JValue&& value);
+        void pushFront(JArray&& array);
+        void pushFront(JObject&& object);
+        void append(JValue&& value);
+        void append(JArray&& array);
+        void append(JObject&& object);
+        void insert(size_t index, JValue&& value);
+        void insert(size_t index, JArray&& value);
+        void insert(size_t index, JObject&& value);
+        /// 在末尾追加新的空容器并返回其引用，用于原位构建子节点；引用在复制本数组后失效
+        JArray& emplaceArray();
+        JObject& emplaceObject();
         void remove(size_t index);
         void popFront();
         void popBack();
@@ -170,49 +365,425 @@ namespace Json {
         JArray& operator<<(const JValue& value);
         JArray& operator<<(const JArray& array);
         JArray& operator<<(const JObject& object);
+        JArray& operator<<(JValue&& value);
+        JArray& operator<<(JArray&& array);
+        JArray& operator<<(JObject&& object);
         JValue& operator[](size_t index);
+
+        /// 解析得到的全为整数（或全为浮点数）的数组以紧凑形式存储，可直接以 span 访问；
+        /// 其他数组返回空 span。任何修改都会把数组转换回普通存储
+        [[nodiscard]] std::span<const int64_t> integers() const;
+        [[nodiscard]] std::span<const double> doubles() const;
+        /// 数值归约，紧凑存储时使用 SIMD；整数按 int64 累加。含非数值元素时抛出 GetBadValueException，
+        /// 空数组的 min / max / mean 同样抛出
+        [[nodiscard]] double sum() const;
+        [[nodiscard]] double min() const;
+        [[nodiscard]] double max() const;
+        [[nodiscard]] double mean() const;
+    private:
+        friend class JParser;
+        friend class JNode;
+        struct Packed;
+        /// 元素不少于该数量时才考虑紧凑存储
+        static constexpr size_t PACK_THRESHOLD = 8;
+
+        /// 紧凑存储时返回 nullptr（下标越界时仍抛出 std::out_of_range）
+        [[nodiscard]] const JValue *element(size_t index) const;
+        Internal::SharedVector<JValue> &write();
+        /// values 全为整数或全为浮点数时改为紧凑存储（丢弃原有内容）并返回 true
+        bool pack(std::span<const JValue> values);
+        /// 写时复制：副本之间共享存储，修改前若存储被共享则先复制。复制容器会使此前经 emplaceArray / emplaceObject、
+        /// get、operator[] 或可写迭代器取得的引用、指针与迭代器失效：之后通过它们写入可能同时改变副本，须在复制后重新取得
+        Internal::SharedVector<JValue> _dict;
+        /// 紧凑存储的数值，与 _dict 至多一个非空；只读，只有 get() 会在其中缓存展开结果
+        std::shared_ptr<const Packed> _packed;
+    };
+
+    /// 紧凑的 JSON 值（16 字节）：字符串与数组、对象的元素存放在单独分配的连续内存块中
+    /// 单一所有权（复制即深复制），不使用 shared_ptr 与原子引用计数；对象保持键的插入顺序
+    class JNode {
+    public:
+        struct Member;
+
+        JNode() noexcept;
+        explicit JNode(bool value) noexcept;
+        explicit JNode(int32_t value) noexcept;
+        explicit JNode(int64_t value) noexcept;
+        explicit JNode(float value) noexcept;
+        explicit JNode(double value) noexcept;
+        explicit JNode(std::string_view value);
+        explicit JNode(const char *value);
+        explicit JNode(const JValue &value);
+        explicit JNode(const JObject &object);
+        explicit JNode(const JArray &array);
+        JNode(const JNode &other);
+        JNode(JNode &&other) noexcept;
+        JNode &operator=(const JNode &other);
+        JNode &operator=(JNode &&other) noexcept;
+        ~JNode();
+
+        static JNode array(size_t capacity = 0);
+        static JNode object(size_t capacity = 0);
+
+        [[nodiscard]] JDataType type() const;
+        /// 数组、对象的元素个数，字符串的字节数，其他类型为 0
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] std::span<const JNode> items() const;
+        [[nodiscard]] std::span<JNode> items();
+        [[nodiscard]] std::span<const Member> members() const;
+        [[nodiscard]] std::span<Member> members();
+        [[nodiscard]] const JNode &at(size_t index) const;
+        JNode &at(size_t index);
+        /// 不是对象或键不存在时返回 nullptr
+        [[nodiscard]] const JNode *find(std::string_view key) const;
+        JNode *find(std::string_view key);
+        [[nodiscard]] const JNode &get(std::string_view key) const;
+
+        void pushBack(JNode value);
+        void set(std::string_view key, JNode value);
+        [[nodiscard]] JValue toValue() const;
     private:
-        std::vector<JValue> _dict;
+        friend class JGet;
+        friend class JParser;
+        friend class JDocument;
+        friend class JWriter;
+        /// External：字符串或内存块位于 JDocument 的内存区域中，不由节点释放
+        /// Indexed：JDocument::freeze() 生成的对象，成员之后附有完美哈希索引
+        enum Flag : uint8_t {
+            External = 1,
+            Indexed = 2
+        };
+        struct Block {
+            uint32_t size;
+            uint32_t capacity;
+        };
+        union Payload {
+            bool boolean;
+            int64_t integer;
+            float real32;
+            double real;
+            char *text;
+            Block *block;
+        };
+
+        /// 成员不超过该数量的冻结对象仍然顺序查找
+        static constexpr size_t FROZEN_LINEAR = 8;
+
+        static Block *allocate(size_t capacity, size_t element_size, std::pmr::memory_resource *resource = nullptr,
+                               size_t extra = 0);
+        static JNode text(std::string_view value, std::pmr::memory_resource *resource);
+        /// 直接引用 value 所在的内存，不复制；调用者保证其生命周期
+        static JNode borrow(std::string_view value);
+        static JNode container(JDataType type, size_t capacity, std::pmr::memory_resource *resource);
+        /// 在 resource 中按深度优先顺序连续构建只读副本，成员较多的对象附带完美哈希索引
+        static JNode frozen(const JValue &value, std::pmr::memory_resource *resource);
+        static JNode frozen(const JObject &object, std::pmr::memory_resource *resource);
+        static JNode frozen(const JArray &array, std::pmr::memory_resource *resource);
+        void buildIndex();
+        [[nodiscard]] const Member *findIndexed(std::string_view key) const;
+        [[nodiscard]] JNode *itemData() const;
+        [[nodiscard]] Member *memberData() const;
+        [[nodiscard]] std::string_view text() const;
+        void reserve(size_t capacity);
+        void release() noexcept;
+
+        Payload _value{.integer = 0};
+        uint32_t _length{0};
+        uint8_t _type{Null};
+        uint8_t _flags{0};
+    };
+
+    struct JNode::Member {
+        JNode key;
+        JNode value;
+    };
+
+    /// 事件式（SAX）解析回调：JParser::parse(json, handler) 按文档顺序调用，不构建 JObject / JArray
+    /// 任一回调返回 false 时解析立即停止
+    class JHandler {
+    public:
+        virtual ~JHandler() = default;
+
+        virtual bool onNull() { return true; }
+        virtual bool onBool(bool) { return true; }
+        virtual bool onInt64(int64_t) { return true; }
+        virtual bool onDouble(double) { return true; }
+        /// 传入的字符串仅在回调期间有效
+        virtual bool onString(std::string_view) { return true; }
+        virtual bool onKey(std::string_view) { return true; }
+        virtual bool onStartObject() { return true; }
+        virtual bool onEndObject() { return true; }
+        virtual bool onStartArray() { return true; }
+        virtual bool onEndArray() { return true; }
+        /// 一个完整的顶层文档解析结束
+        virtual bool onEndDocument() { return true; }
     };
 
     class JParser {
     public:
+        enum ParseMode {
+            SinglePass,
+            TwoPass
+        };
+
         explicit JParser(JObject root_object);
         explicit JParser(JArray root_array);
+        /// max_cols_inline 已不再使用（文件整体映射后解析，不限制行长度），仅为兼容保留
         explicit JParser(const std::string &file_name, uint32_t max_cols_inline = 1024);
         explicit JParser();
 
         void parse(const std::string &json);
+        static bool parse(const std::string &json, JHandler &handler);
+        /// 解析为紧凑的 JNode 树（单线程、单遍）；输入为空时返回 null
+        static JNode parseNode(const std::string &json);
+        static std::string dump(const JNode &node, uint8_t space = 2);
+        /// 原地解析：buffer 会被改写（字符串在其中反转义），解析失败后其内容不再可用；
+        /// 传给 handler 的字符串指向 buffer，在 buffer 释放或改写之前一直有效
+        static bool parseInSitu(char *buffer, size_t size, JHandler &handler);
         bool parseFromJsonFile(const std::string &file_name, uint32_t max_cols_inline = 1024);
+        /// space 为 0 时输出不含任何空白的紧凑 JSON
         std::string dump(uint8_t space = 2);
+        /// 根对象或根数组写入 writer，缩进由 writer 决定
+        void dump(JWriter &writer);
         bool dumpToJsonFile(const std::string& file_name, uint8_t space = 2);
         const JObject & object() const;
         const JArray & array() const;
         void setRootObject(JObject root_object);
         void setRootArray(JArray root_array);
+        void setParseMode(ParseMode mode);
+        [[nodiscard]] ParseMode parseMode() const;
+        void setThreads(size_t threads);
+        [[nodiscard]] size_t threads() const;
     private:
+        friend class JLinesParser;
+        friend class JDocument;
+        template<typename Handler>
+        class Reader;
+        class DomBuilder;
+        class NodeBuilder;
+        enum class TokenKind : uint8_t {
+            BeginObject,
+            EndObject,
+            BeginArray,
+            EndArray,
+            Comma,
+            Colon,
+            String,
+            Number,
+            True,
+            False,
+            Null
+        };
         struct Token {
-            std::string type;
-            std::string value;
-            size_t line;
-            size_t col;
+            size_t offset;
+            uint32_t length;
+            TokenKind kind;
         };
-        std::string parseObject(const JObject &object, const std::string &spacer, uint8_t indentation_level);
-        std::string parseArray(const Json::JArray *array, const std::string &spacer, uint8_t indentation_level);
-
-        static std::string stripZero(const float& f);
-        static std::string stripZero(const double& d);
-        static std::vector<Token> extract(const std::string &json, uint32_t &line, uint32_t &col);
-        static Token extractString(const std::string &json, size_t &pos, uint32_t &line, uint32_t &col);
-        static Token extractNumber(const std::string &json, size_t &pos, uint32_t &line, uint32_t &col);
-        static bool hasLastOfType(const std::vector<Token> &tokens, const std::string &type,
-                                  const std::string &ends_with_type = "");
-        static JObject parseObject(const std::vector<Token>& tokens, size_t& pos);
-        static JArray parseArray(const std::vector<Token>& tokens, size_t& pos);
-        static JValue parseValue(const Token& token);
+        /// borrow 为 true 时不含转义的字符串与键直接引用 json，调用者保证 json 比返回的节点存活更久
+        static JNode parseNode(std::string_view json, std::pmr::memory_resource *resource, bool borrow = false);
+        /// 原地解析：含转义的字符串在 buffer 中反转义，所有字符串与键都直接引用 buffer
+        static JNode parseNode(char *buffer, size_t size, std::pmr::memory_resource *resource);
+
+        void load(std::string_view json);
+        bool loadParallel(std::string_view json);
+        void assignRoot(char root, JObject &object, JArray &array);
+
+        static std::string location(std::string_view json, size_t pos);
+        static const char* tokenName(TokenKind kind);
+        static std::vector<uint32_t> structuralIndex(std::string_view json, size_t &string_newline);
+        static std::vector<Token> extract(std::string_view json);
+        static Token extractNumber(std::string_view json, size_t &pos);
+        static JObject parseObject(std::string_view json, const std::vector<Token>& tokens, size_t& pos);
+        static JArray parseArray(std::string_view json, const std::vector<Token>& tokens, size_t& pos);
+        static void parseValue(std::string_view json, const std::vector<Token>& tokens, size_t& pos, JValue& value);
         std::string _json;
         JObject _root_object;
         JArray _root_array;
+        ParseMode _parse_mode{SinglePass};
+        size_t _threads{1};
+    };
+
+    /// 流式序列化：输出先追加到缓冲区，缓冲区超过 buffer_size 时整块交给输出端后清空，
+    /// 内存占用只与缓冲区大小有关，与文档大小和深度无关；输出格式与 JParser::dump 相同，
+    /// space 为 0 时输出不含任何空白的紧凑 JSON
+    class JWriter {
+    public:
+        using Sink = std::function<void(std::string_view)>;
+        static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+        /// 直接追加到 output 末尾，不经过中间缓冲区
+        explicit JWriter(std::string &output, uint8_t space = 2);
+        explicit JWriter(std::ostream &stream, uint8_t space = 2, size_t buffer_size = DEFAULT_BUFFER_SIZE);
+        /// 写入文件描述符（不负责关闭）
+        explicit JWriter(int fd, uint8_t space = 2, size_t buffer_size = DEFAULT_BUFFER_SIZE);
+        explicit JWriter(Sink sink, uint8_t space = 2, size_t buffer_size = DEFAULT_BUFFER_SIZE);
+        JWriter(const JWriter &) = delete;
+        JWriter &operator=(const JWriter &) = delete;
+        /// 析构时写出剩余内容并忽略错误；需要得知写入是否成功时先调用 flush()
+        ~JWriter();
+
+        void write(const JObject &object);
+        void write(const JArray &array);
+        void write(const JValue &value);
+        void write(const JNode &node);
+        /// 把缓冲区的内容交给输出端；写入失败时抛出 std::runtime_error
+        void flush();
+        /// 元素较多的数组与对象分段交给线程池格式化，再按顺序拼接，输出与单线程完全相同；0 表示使用全部硬件线程
+        void setThreads(size_t threads);
+        [[nodiscard]] size_t threads() const;
+    private:
+        void writeObject(const JObject &object, size_t level);
+        void writeArray(const JArray &array, size_t level);
+        void writeValue(const JValue &value, size_t level);
+        void writeNode(const JNode &node, size_t level);
+        void writeKey(std::string_view key);
+        void writeString(std::string_view value);
+        void indent(size_t level);
+        void next(bool first, size_t level);
+        void close(char bracket, size_t level);
+        /// 写出 size 个元素及其之间的分隔符，item(writer, i) 只写第 i 个元素本身
+        template<typename Item>
+        void writeItems(size_t size, size_t level, const Item &item);
+        /// 缓冲区超过 buffer_size 时写出
+        void spill();
+
+        std::string _buffer;
+        /// 指向 _buffer，或构造时传入的字符串
+        std::string *_output;
+        Sink _sink;
+        size_t _buffer_size;
+        std::string _spacer;
+        /// space 为 0 时不输出任何空白
+        bool _compact;
+        size_t _threads{1};
+    };
+
+    /// 增量（推送式）解析器：输入可以按任意大小分块送入，解析事件发送给 JHandler
+    /// 同一输入流中可以依次包含多个 JSON 文档
+    class JStreamParser {
+    public:
+        explicit JStreamParser(JHandler &handler);
+
+        bool feed(const char *data, size_t size);
+        bool feed(std::string_view data);
+        void finish();
+        void reset();
+        [[nodiscard]] bool complete() const;
+        [[nodiscard]] size_t documents() const;
+    private:
+        enum class Expect : uint8_t {
+            Document,
+            Value,
+            ValueOrEnd,
+            Key,
+            KeyOrEnd,
+            Colon,
+            CommaOrEnd
+        };
+        enum class Lexer : uint8_t {
+            Structure,
+            String,
+            Escape,
+            Scalar
+        };
+        struct Mark {
+            size_t line;
+            size_t col;
+        };
+        struct Scope {
+            char kind;
+            Mark begin;
+        };
+
+        [[nodiscard]] Mark mark() const;
+        static std::string where(const Mark &mark);
+        bool structure(char c);
+        bool scanString();
+        bool scanScalar();
+        bool flushScalar();
+        bool afterValue();
+        [[noreturn]] void unexpected(const std::string &name) const;
+        [[noreturn]] void uncompleted() const;
+
+        JHandler &_handler;
+        std::vector<Scope> _stack;
+        std::string _token;
+        std::string _unescaped;
+        Mark _token_begin{1, 1};
+        Mark _comma{1, 1};
+        Expect _expect{Expect::Document};
+        Lexer _lexer{Lexer::Structure};
+        bool _is_key{false};
+        bool _has_escape{false};
+        bool _stopped{false};
+        size_t _documents{0};
+        const char *_data{nullptr};
+        size_t _size{0};
+        size_t _pos{0};
+        size_t _offset{0};
+        size_t _line{1};
+        size_t _line_begin{0};
+    };
+
+    /// 以 JNode 树保存的解析结果：全部节点和字符串分配在文档自己的内存区域中，
+    /// 销毁、clear() 或重新解析时整块释放，不逐个释放节点；root() 只读，需要修改时复制出来
+    class JDocument {
+    public:
+        explicit JDocument();
+        JDocument(JDocument &&other) noexcept;
+        JDocument &operator=(JDocument &&other) noexcept;
+        JDocument(const JDocument &) = delete;
+        JDocument &operator=(const JDocument &) = delete;
+        ~JDocument();
+
+        void parse(const std::string &json);
+        /// 文档接管 json；不含转义的字符串与键直接引用其中的字符，不再复制到内存区域
+        void parseRetained(std::string json);
+        /// 原地解析：buffer 会被改写，所有字符串与键（包括含转义的）都直接引用其中的字符，内存区域只存放节点；
+        /// 调用者须在文档使用期间保持 buffer 有效且不被改写
+        void parseInSitu(char *buffer, size_t size);
+        /// 将已有的树复制为只读文档：内容连续存放在内存区域中，成员较多的对象使用完美哈希查找；
+        /// 文档不再修改期间可以被多个线程同时读取
+        void freeze(const JObject &object);
+        void freeze(const JArray &array);
+        bool parseFromJsonFile(const std::string &file_name);
+        void clear();
+        [[nodiscard]] const JNode &root() const;
+        /// parseRetained() 保留的原文，其他情况下为空
+        [[nodiscard]] std::string_view source() const;
+        /// 内存区域当前向系统申请的字节数（clear() 后保留最大的一块供下次解析复用）
+        [[nodiscard]] size_t reservedBytes() const;
+    private:
+        class Arena;
+        void load(std::string_view json, bool borrow = false);
+
+        std::unique_ptr<Arena> _arena;
+        /// 放在堆上，移动文档时字符地址不变
+        std::unique_ptr<std::string> _source;
+        JNode _root;
+    };
+
+    /// JSON Lines 中一行的解析结果；error 非空表示该行解析失败
+    struct JLine {
+        size_t number{0};
+        JParser document;
+        std::string error;
+    };
+
+    /// JSON Lines（NDJSON）批量解析器：按行切分输入并在工作线程上并行解析
+    class JLinesParser {
+    public:
+        explicit JLinesParser(size_t threads = 0);
+
+        void parse(std::string_view text, const std::function<void(JLine&)> &callback) const;
+        std::vector<JLine> parse(std::string_view text) const;
+        bool parseFromFile(const std::string &file_name, const std::function<void(JLine&)> &callback) const;
+        void setOrdered(bool ordered);
+        [[nodiscard]] bool ordered() const;
+        [[nodiscard]] size_t threads() const;
+    private:
+        size_t _threads;
+        bool _ordered{true};
     };
 
     class JGet {
@@ -238,6 +809,23 @@ namespace Json {
         static bool isString(const JValue& value);
         static bool isArray(const JValue& value);
         static bool isObject(const JValue& value);
+
+        static bool toBool(const JNode& node);
+        static int32_t toInt(const JNode& node);
+        static int64_t toBigInt(const JNode& node);
+        static float toFloat(const JNode& node);
+        static double toDouble(const JNode& node);
+        static std::string_view toString(const JNode& node);
+
+        static bool isNull(const JNode& node);
+        static bool isBool(const JNode& node);
+        static bool isInt(const JNode& node);
+        static bool isBigInt(const JNode& node);
+        static bool isFloat(const JNode& node);
+        static bool isDouble(const JNode& node);
+        static bool isString(const JNode& node);
+        static bool isArray(const JNode& node);
+        static bool isObject(const JNode& node);
     };
 
     std::string escToString(const std::string& str);
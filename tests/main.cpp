@@ -2,6 +2,7 @@
 #include "tests/JArray.h"
 #include "tests/JObject.h"
 #include "tests/JParser.h"
+#include "tests/JNode.h"
 #include "tests/JPerformanceTest.h"
 
 void showAvaliableTestCases() {
@@ -10,6 +11,7 @@ void showAvaliableTestCases() {
     std::cout << "- object\n";
     std::cout << "- array\n";
     std::cout << "- parser\n";
+    std::cout << "- node\n";
     std::cout << "- performance\n";
 }
 
@@ -44,6 +46,8 @@ int main(int argc, char* argv[]) {
             return Test_Array::start();
         } else if (test_case == "parser") {
             return Test_Parser::start();
+        } else if (test_case == "node") {
+            return Test_Node::start();
         } else if (test_case == "performance") {
             return Test_Performance::start();
         } else {
@@ -3,6 +3,9 @@
 #define JSONBUILDERTESTCASE_JARRAY_H
 #include "../../src/Json.h"
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <string>
 
 namespace Test_Array {
     void test1() {
@@ -197,12 +200,220 @@ namespace Test_Array {
         std::cout << "All error handling and edge case tests passed!\n";
     }
 
+    void test5() {
+        std::cout << "\nTest 5: Move-aware Building\n";
+        std::cout << "---------------------------\n";
+
+        std::cout << "Testing moved children are attached without copies...";
+        Json::JArray rows;
+        for (int i = 0; i < 3; ++i) {
+            Json::JObject row;
+            row.set("id", i);
+            Json::JArray cells;
+            cells << 1 << 2;
+            const Json::JValue *first_cell = &*cells.begin();
+            row.set("cells", std::move(cells));
+            assert(&*row.toArray("cells")->begin() == first_cell);
+            rows.pushBack(std::move(row));
+        }
+        assert(rows.size() == 3 && rows.toObject(2)->toInt("id") == 2);
+        Json::JArray front;
+        front << Json::JArray() << Json::JObject();
+        rows.pushFront(std::move(front));
+        rows.insert(1, Json::JObject());
+        assert(rows.size() == 5 && rows.toArray(0)->size() == 2 && rows.toObject(1)->size() == 0);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing shared children are attached by pointer...";
+        auto shared = std::make_shared<Json::JObject>();
+        shared->set("name", "shared");
+        Json::JArray holder;
+        holder.pushBack(shared);
+        Json::JObject owner;
+        owner.set("child", std::move(shared));
+        assert(holder.toObject(0) == owner.toObject("child"));
+        std::cout << " ✓\n";
+
+        std::cout << "Testing children built in place...";
+        Json::JArray table;
+        Json::JObject &entry = table.emplaceObject();
+        entry.set("name", "in place");
+        Json::JArray &tags = entry.emplaceArray("tags");
+        tags.emplaceArray().pushBack(1);
+        Json::JObject &meta = entry.emplaceObject("meta");
+        meta.set("level", 2);
+        assert(table.toObject(0)->toArray("tags")->toArray(0)->toInt(0) == 1);
+        assert(table.toObject(0)->toObject("meta")->toInt("level") == 2);
+        Json::JArray from_vector(std::vector<Json::JValue>{1, "two", 3.0});
+        assert(from_vector.size() == 3 && from_vector.toString(1) == "two");
+        std::cout << " ✓\n";
+
+        std::cout << "All move-aware building tests passed!\n";
+    }
+
+    void test6() {
+        std::cout << "\nTest 6: Packed Numeric Arrays\n";
+        std::cout << "-----------------------------\n";
+
+        std::cout << "Testing homogeneous arrays are packed while parsing...";
+        const std::string json = R"({"ints": [3, -1, 4, 1, 5, 9, 2, 6, 5, 3, 5, 8589934592],)"
+                                 R"( "reals": [0.5, -1.25, 2.0, 3.5, 1e3, -0.0, 7.75, 8.5, 9.125],)"
+                                 R"( "mixed": [1, 2, 3, 4, 5, 6, 7, 8.5], "short": [1, 2, 3]})";
+        for (auto mode : {Json::JParser::SinglePass, Json::JParser::TwoPass}) {
+            Json::JParser parser;
+            parser.setParseMode(mode);
+            parser.parse(json);
+            const Json::JObject &root = parser.object();
+            const Json::JArray *ints = root.toArray("ints");
+            const Json::JArray *reals = root.toArray("reals");
+            assert(ints->integers().size() == 12 && ints->doubles().empty());
+            assert(ints->integers()[11] == 8589934592LL && ints->toInt(1) == -1);
+            assert(reals->doubles().size() == 9 && reals->integers().empty());
+            assert(reals->toDouble(4) == 1000.0);
+            assert(root.toArray("mixed")->integers().empty() && root.toArray("mixed")->doubles().empty());
+            assert(root.toArray("short")->integers().empty());
+            // Element access still sees the types the parser would have produced
+            assert(ints->get(0).index() == Json::JDataType::Int);
+            assert(ints->get(11).index() == Json::JDataType::BigInt);
+            assert(reals->get(2).index() == Json::JDataType::Double);
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "Testing read-only access to packed arrays...";
+        {
+            Json::JParser parser;
+            parser.parse(json);
+            const Json::JArray *ints = parser.object().toArray("ints");
+            int64_t total = 0;
+            size_t big = 0;
+            for (const auto &value : *ints) {
+                if (const auto *small = std::get_if<int32_t>(&value)) {
+                    total += *small;
+                } else {
+                    total += std::get<int64_t>(value);
+                    big++;
+                }
+            }
+            assert(total == 8589934592LL + 42 && big == 1);
+            assert(std::get<double>(*parser.object().toArray("reals")->begin()) == 0.5);
+            assert(!ints->isNull(0) && ints->toBigInt(11) == 8589934592LL);
+            bool caught = false;
+            try {
+                (void) ints->toString(0);
+            } catch (const Json::JException::GetBadValueException &) {
+                caught = true;
+            }
+            assert(caught);
+            caught = false;
+            try {
+                (void) ints->isNull(12);
+            } catch (const std::out_of_range &) {
+                caught = true;
+            }
+            assert(caught && ints->integers().size() == 12);
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "Testing dump output is unchanged...";
+        Json::JParser packed_parser;
+        packed_parser.parse(json);
+        std::string packed_dump = packed_parser.dump();
+        Json::JObject copy = packed_parser.object();
+        // Writable element access converts the copies back to ordinary storage
+        (void) (*std::get<std::shared_ptr<Json::JArray>>(copy["ints"]))[0];
+        (void) (*std::get<std::shared_ptr<Json::JArray>>(copy["reals"]))[0];
+        assert(copy.toArray("ints")->integers().empty());
+        Json::JParser plain_parser(copy);
+        assert(plain_parser.dump() == packed_dump);
+        assert(packed_parser.dump(0) == plain_parser.dump(0));
+        std::cout << " ✓\n";
+
+        std::cout << "Testing mutation unpacks only the modified copy...";
+        Json::JArray values = *packed_parser.object().toArray("ints");
+        Json::JArray snapshot = values;
+        values.pushBack("tail");
+        assert(values.integers().empty() && values.size() == 13 && values.toString(12) == "tail");
+        assert(values.toBigInt(11) == 8589934592LL);
+        assert(snapshot.integers().size() == 12);
+        values[0] = 100;
+        assert(values.toInt(0) == 100 && snapshot.toInt(0) == 3);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing reductions...";
+        const Json::JArray *ints = packed_parser.object().toArray("ints");
+        const Json::JArray *reals = packed_parser.object().toArray("reals");
+        assert(ints->sum() == 8589934592.0 + 42 && ints->min() == -1 && ints->max() == 8589934592.0);
+        assert(reals->sum() == 1030.125 && reals->min() == -1.25 && reals->max() == 1000.0);
+        assert(reals->mean() == 1030.125 / 9);
+        // Unpacked arrays give the same results and reject non-numeric elements
+        Json::JArray plain = *reals;
+        plain.pushBack(1);
+        assert(plain.doubles().empty() && plain.sum() == 1031.125 && plain.min() == -1.25);
+        bool caught = false;
+        try {
+            plain.pushBack("text");
+            (void) plain.sum();
+        } catch (const Json::JException::GetBadValueException &) {
+            caught = true;
+        }
+        assert(caught);
+        caught = false;
+        try {
+            (void) Json::JArray().max();
+        } catch (const Json::JException::GetBadValueException &) {
+            caught = true;
+        }
+        assert(caught && Json::JArray().sum() == 0.0);
+        std::cout << " ✓\n";
+
+        std::cout << "All packed numeric array tests passed!\n";
+    }
+
+    void test7() {
+        std::cout << "\nTest 7: Large Integer Reductions\n";
+        std::cout << "--------------------------------\n";
+
+        std::cout << "Testing sums beyond int64 do not wrap...";
+        std::string json = "[";
+        Json::JArray appended;
+        for (int i = 0; i < 8; ++i) {
+            json += (i ? ", " : "") + std::to_string(INT64_MAX);
+            appended << int64_t(INT64_MAX);
+        }
+        Json::JParser parser;
+        parser.parse(json + "]");
+        const Json::JArray &packed = parser.array();
+        assert(packed.integers().size() == 8 && appended.integers().empty());
+        const double expected = 8.0 * static_cast<double>(INT64_MAX);
+        assert(packed.sum() == expected && appended.sum() == expected);
+        assert(packed.mean() == static_cast<double>(INT64_MAX) && appended.mean() == packed.mean());
+        std::cout << " ✓\n";
+
+        std::cout << "Testing negative overflow and exact cancellation...";
+        Json::JArray negative;
+        for (int i = 0; i < 11; ++i) negative << int64_t(INT64_MIN);
+        assert(negative.sum() == std::ldexp(-11.0, 63));
+        // Intermediate sums leave the int64 range but the total is small and exact
+        std::string mixed_json = "[";
+        for (int i = 0; i < 9; ++i) mixed_json += std::to_string(INT64_MAX) + ", ";
+        for (int i = 0; i < 9; ++i) mixed_json += std::to_string(-INT64_MAX) + ", ";
+        parser.parse(mixed_json + "3]");
+        assert(parser.array().integers().size() == 19);
+        assert(parser.array().sum() == 3.0 && parser.array().min() == static_cast<double>(-INT64_MAX));
+        std::cout << " ✓\n";
+
+        std::cout << "All large integer reduction tests passed!\n";
+    }
+
     int start() {
         std::cout << "======= JArray Test Case =======\n";
         test1();
         test2();
         test3();
         test4();
+        test5();
+        test6();
+        test7();
         std::cout << "=================================\n";
         return 0;
     }
@@ -0,0 +1,310 @@
+#pragma once
+#ifndef JSONBUILDERTESTCASE_JNODE_H
+#define JSONBUILDERTESTCASE_JNODE_H
+#include "../../src/Json.h"
+#include <atomic>
+#include <cassert>
+#include <thread>
+
+namespace Test_Node {
+    void test1() {
+        std::cout << "\nTest 1: Basic Node Operations\n";
+        std::cout << "-----------------------------\n";
+
+        std::cout << "Testing the node stays 16 bytes...";
+        assert(sizeof(Json::JNode) == 16);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing scalar values...";
+        assert(Json::JGet::isNull(Json::JNode()));
+        assert(Json::JGet::toBool(Json::JNode(true)));
+        assert(Json::JGet::isInt(Json::JNode(42)) && Json::JGet::toInt(Json::JNode(42)) == 42);
+        assert(Json::JGet::isBigInt(Json::JNode(int64_t(1) << 40)));
+        assert(Json::JGet::toBigInt(Json::JNode(int64_t(1) << 40)) == (int64_t(1) << 40));
+        assert(Json::JGet::toBigInt(Json::JNode(-7)) == -7);
+        assert(Json::JGet::toFloat(Json::JNode(1.5f)) == 1.5f);
+        assert(Json::JGet::toDouble(Json::JNode(2.25)) == 2.25);
+        assert(Json::JGet::toString(Json::JNode("hello")) == "hello");
+        assert(Json::JGet::toString(Json::JNode("")).empty());
+        std::cout << " ✓\n";
+
+        std::cout << "Testing arrays and objects...";
+        Json::JNode array = Json::JNode::array();
+        for (int i = 0; i < 100; ++i) array.pushBack(Json::JNode(i));
+        assert(array.size() == 100);
+        assert(Json::JGet::toInt(array.at(99)) == 99);
+
+        Json::JNode object = Json::JNode::object();
+        object.set("name", Json::JNode("node"));
+        object.set("list", std::move(array));
+        object.set("name", Json::JNode("renamed"));
+        assert(object.size() == 2);
+        assert(Json::JGet::toString(object.get("name")) == "renamed");
+        assert(object.members()[0].value.type() == Json::String);
+        assert(object.find("list")->size() == 100);
+        assert(object.find("missing") == nullptr);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing copies are deep...";
+        Json::JNode copy = object;
+        copy.find("list")->pushBack(Json::JNode(100));
+        assert(copy.get("list").size() == 101);
+        assert(object.get("list").size() == 100);
+        std::cout << " ✓\n";
+
+        std::cout << "All basic node tests passed!\n";
+    }
+
+    void test2() {
+        std::cout << "\nTest 2: Error Handling\n";
+        std::cout << "----------------------\n";
+
+        Json::JNode object = Json::JNode::object();
+        object.set("value", Json::JNode(1));
+
+        std::cout << "Testing missing keys...";
+        try {
+            (void) object.get("missing");
+            assert(false);
+        } catch (const Json::JException::KeyIsNotFoundException& e) {
+            assert(std::string(e.what()) == "The key 'missing' is not found in object!");
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "Testing out of range indexes...";
+        try {
+            (void) Json::JNode::array().at(0);
+            assert(false);
+        } catch (const std::out_of_range&) {}
+        std::cout << " ✓\n";
+
+        std::cout << "Testing wrong value types...";
+        try {
+            (void) Json::JGet::toString(object.get("value"));
+            assert(false);
+        } catch (const Json::JException::GetBadValueException&) {}
+        try {
+            object.pushBack(Json::JNode());
+            assert(false);
+        } catch (const Json::JException::GetBadValueException&) {}
+        std::cout << " ✓\n";
+
+        std::cout << "All error handling tests passed!\n";
+    }
+
+    void test3() {
+        std::cout << "\nTest 3: Parsing and Conversion\n";
+        std::cout << "------------------------------\n";
+
+        std::string json = R"({"id": 7, "big": 9223372036854775807, "ratio": 0.5, "ok": true, "none": null,
+                              "name": "a\"b", "tags": ["x", "y", {"deep": []}], "id": 8})";
+
+        std::cout << "Testing parsing into nodes...";
+        Json::JNode root = Json::JParser::parseNode(json);
+        assert(root.type() == Json::Object);
+        assert(root.size() == 7);
+        assert(Json::JGet::toInt(root.get("id")) == 8);
+        assert(Json::JGet::toBigInt(root.get("big")) == INT64_MAX);
+        assert(Json::JGet::toDouble(root.get("ratio")) == 0.5);
+        assert(Json::JGet::isNull(root.get("none")));
+        assert(Json::JGet::toString(root.get("name")) == "a\"b");
+        assert(root.get("tags").at(2).get("deep").type() == Json::Array);
+        assert(Json::JParser::parseNode("").type() == Json::Null);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing conversion to and from JValue...";
+        Json::JParser parser;
+        parser.parse(json);
+        Json::JNode from_tree(parser.object());
+        Json::JValue value = root.toValue();
+        assert(Json::JGet::toObject(value)->toInt("id") == 8);
+        assert(Json::JGet::toObject(value)->toArray("tags")->size() == 3);
+        assert(Json::JGet::toInt(from_tree.get("id")) == 8);
+        assert(Json::JGet::toString(from_tree.get("tags").at(1)) == "y");
+        std::cout << " ✓\n";
+
+        std::cout << "Testing dump matches the tree output...";
+        std::string array_json = R"([1, 2.5, "s", null, [true, {"k": [3]}], {}])";
+        Json::JParser array_parser;
+        array_parser.parse(array_json);
+        assert(Json::JParser::dump(Json::JParser::parseNode(array_json)) == array_parser.dump());
+        assert(Json::JParser::dump(Json::JParser::parseNode(array_json), 4) == array_parser.dump(4));
+        std::cout << " ✓\n";
+
+        std::cout << "All parsing and conversion tests passed!\n";
+    }
+
+    void test4() {
+        std::cout << "\nTest 4: Arena Documents\n";
+        std::cout << "-----------------------\n";
+
+        std::string json = R"({"users": [{"name": "a", "tags": ["x", "y"]}, {"name": "b\n", "tags": []}], "n": 2})";
+
+        std::cout << "Testing the document matches parseNode...";
+        Json::JDocument document;
+        document.parse(json);
+        assert(Json::JParser::dump(document.root()) == Json::JParser::dump(Json::JParser::parseNode(json)));
+        assert(Json::JGet::toString(document.root().get("users").at(1).get("name")) == "b\n");
+        std::cout << " ✓\n";
+
+        std::cout << "Testing the arena is reused between documents...";
+        size_t reserved = document.reservedBytes();
+        assert(reserved > 0);
+        for (int i = 0; i < 100; ++i) document.parse(json);
+        assert(document.reservedBytes() == reserved);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing copies leave the arena...";
+        Json::JNode copy = document.root();
+        document.clear();
+        assert(Json::JGet::isNull(document.root()));
+        copy.set("n", Json::JNode(3));
+        assert(Json::JGet::toString(copy.get("users").at(0).get("tags").at(1)) == "y");
+        std::cout << " ✓\n";
+
+        std::cout << "Testing errors and moved documents...";
+        try {
+            document.parse(R"({"a": [1, 2})");
+            assert(false);
+        } catch (const Json::JException::ParseJsonError&) {
+            assert(Json::JGet::isNull(document.root()));
+        }
+        Json::JDocument moved = std::move(document);
+        moved.parse(json);
+        assert(Json::JGet::toInt(moved.root().get("n")) == 2);
+        document.parse("[1]");
+        assert(document.root().size() == 1);
+        std::cout << " ✓\n";
+
+        std::cout << "All arena document tests passed!\n";
+    }
+
+    void test5() {
+        std::cout << "\nTest 5: Retained Source Documents\n";
+        std::cout << "---------------------------------\n";
+
+        std::string json = R"({"id": "user_1", "note": "a\"b", "tags": ["x", "y"], "key": "\u0041"})";
+
+        std::cout << "Testing plain strings point into the source...";
+        Json::JDocument document;
+        document.parseRetained(json);
+        std::string_view source = document.source();
+        assert(source == json);
+        auto inside = [&](std::string_view text) {
+            return text.data() >= source.data() && text.data() + text.size() <= source.data() + source.size();
+        };
+        assert(inside(Json::JGet::toString(document.root().get("id"))));
+        assert(inside(Json::JGet::toString(document.root().get("tags").at(1))));
+        assert(inside(Json::JGet::toString(document.root().members()[0].key)));
+        std::cout << " ✓\n";
+
+        std::cout << "Testing escaped strings are decoded into the arena...";
+        assert(Json::JGet::toString(document.root().get("note")) == "a\"b");
+        assert(!inside(Json::JGet::toString(document.root().get("note"))));
+        assert(Json::JGet::toString(document.root().get("key")) == "A");
+        assert(Json::JParser::dump(document.root()) == Json::JParser::dump(Json::JParser::parseNode(json)));
+        std::cout << " ✓\n";
+
+        std::cout << "Testing views survive moves and copies own their strings...";
+        Json::JDocument moved = std::move(document);
+        assert(Json::JGet::toString(moved.root().get("id")) == "user_1");
+        Json::JNode copy = moved.root();
+        moved.parse("[]");
+        assert(moved.source().empty());
+        assert(Json::JGet::toString(copy.get("id")) == "user_1");
+        std::cout << " ✓\n";
+
+        std::cout << "Testing long strings no longer need arena space...";
+        std::string strings = "[";
+        for (int i = 0; i < 1000; ++i) strings += (i ? ", \"" : "\"") + std::string(64, char('a' + i % 26)) + "\"";
+        strings += "]";
+        Json::JDocument copying, retained;
+        copying.parse(strings);
+        retained.parseRetained(strings);
+        assert(Json::JParser::dump(copying.root()) == Json::JParser::dump(retained.root()));
+        assert(retained.reservedBytes() < copying.reservedBytes());
+        std::cout << " ✓\n";
+
+        std::cout << "Testing errors clear the retained source...";
+        try {
+            retained.parseRetained(R"({"a": "b")");
+            assert(false);
+        } catch (const Json::JException::ParseJsonError&) {
+            assert(Json::JGet::isNull(retained.root()) && retained.source().empty());
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "All retained source tests passed!\n";
+    }
+
+    void test6() {
+        std::cout << "\nTest 6: Frozen Documents\n";
+        std::cout << "------------------------\n";
+
+        Json::JObject config;
+        for (int i = 0; i < 1000; ++i) config.set("key" + std::to_string(i), i);
+        Json::JObject &small = config.emplaceObject("small");
+        small.set("a", "x");
+        small.set("b", 2.5);
+        Json::JArray &list = config.emplaceArray("list");
+        list << 1 << "two" << Json::JObject();
+
+        std::cout << "Testing every key is found through the index...";
+        Json::JDocument document;
+        document.freeze(config);
+        const Json::JNode &root = document.root();
+        assert(root.size() == config.size());
+        for (int i = 0; i < 1000; ++i) assert(Json::JGet::toInt(root.get("key" + std::to_string(i))) == i);
+        assert(root.find("key1000") == nullptr && root.find("") == nullptr);
+        assert(Json::JGet::toString(root.get("small").get("a")) == "x");
+        assert(root.get("small").find("c") == nullptr);
+        assert(Json::JGet::toString(root.get("list").at(1)) == "two");
+        std::cout << " ✓\n";
+
+        std::cout << "Testing the frozen tree matches the source...";
+        assert(Json::JParser::dump(root) == Json::JParser::dump(Json::JNode(config)));
+        Json::JDocument frozen_array;
+        frozen_array.freeze(list);
+        assert(frozen_array.root().size() == 3 && Json::JGet::isObject(frozen_array.root().at(2)));
+        std::cout << " ✓\n";
+
+        std::cout << "Testing concurrent readers...";
+        std::atomic<int> failures{0};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t) {
+            readers.emplace_back([&, t] {
+                for (int i = 0; i < 20000; ++i) {
+                    int key = (i * 7 + t) % 1000;
+                    if (Json::JGet::toInt(root.get("key" + std::to_string(key))) != key) failures++;
+                }
+            });
+        }
+        for (auto &reader : readers) reader.join();
+        assert(failures == 0);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing copies are ordinary mutable trees...";
+        Json::JNode copy = root;
+        copy.set("key0", Json::JNode(-1));
+        copy.set("added", Json::JNode(true));
+        assert(Json::JGet::toInt(copy.get("key0")) == -1 && Json::JGet::toBool(copy.get("added")));
+        assert(Json::JGet::toInt(root.get("key0")) == 0);
+        std::cout << " ✓\n";
+
+        std::cout << "All frozen document tests passed!\n";
+    }
+
+    int start() {
+        std::cout << "======= JNode Test Case =======\n";
+        test1();
+        test2();
+        test3();
+        test4();
+        test5();
+        test6();
+        std::cout << "================================\n";
+        return 0;
+    }
+}
+
+#endif //JSONBUILDERTESTCASE_JNODE_H
@@ -2,7 +2,11 @@
 #ifndef JSONBUILDERTESTCASE_JOBJECT_H
 #define JSONBUILDERTESTCASE_JOBJECT_H
 #include "../../src/Json.h"
+#include <atomic>
 #include <cassert>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 namespace Test_Object {
     void test1() {
@@ -179,12 +183,226 @@ namespace Test_Object {
         std::cout << "All nested structure tests passed!\n";
     }
 
+    void test5() {
+        std::cout << "\nTest 5: Insertion Order and Indexed Lookup\n";
+        std::cout << "------------------------------------------\n";
+
+        std::cout << "Testing keys keep insertion order...";
+        Json::JObject obj;
+        obj.set("zeta", 1);
+        obj.set("alpha", 2);
+        obj.set("mid", 3);
+        obj.set("alpha", 4);
+        std::vector<std::string> expected = {"zeta", "alpha", "mid"};
+        assert(obj.keys() == expected);
+        assert(obj.toInt("alpha") == 4);
+        obj.remove("zeta");
+        expected = {"alpha", "mid"};
+        assert(obj.keys() == expected);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing lookups past the index threshold...";
+        Json::JObject large;
+        for (int i = 0; i < 1000; ++i) large.set("key" + std::to_string(i), i);
+        assert(large.size() == 1000);
+        for (int i = 0; i < 1000; ++i) assert(large.toInt("key" + std::to_string(i)) == i);
+        assert(!large.valid("key1000"));
+        for (int i = 0; i < 1000; i += 2) large.remove("key" + std::to_string(i));
+        assert(large.size() == 500);
+        assert(!large.valid("key10") && large.toInt("key11") == 11);
+        int previous = -1;
+        for (const auto &[key, value] : large) {
+            int current = std::get<int32_t>(value);
+            assert(current > previous && current % 2 == 1);
+            previous = current;
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "Testing iterators write values but not keys...";
+        static_assert(std::is_same_v<decltype((*large.begin()).first), const std::string &>);
+        static_assert(!std::is_assignable_v<decltype((large.begin()->first)), std::string>);
+        for (auto it = large.begin(); it != large.end(); ++it) it->second = std::get<int32_t>(it->second) * 10;
+        for (auto [key, value] : large) value = std::get<int32_t>(value) + 1;
+        assert(large.toInt("key11") == 111 && large.toInt("key999") == 9991);
+        Json::JObject::constIterator first = large.begin();
+        assert(first->first == "key1");
+        std::cout << " ✓\n";
+
+        std::cout << "Testing dump follows insertion order...";
+        Json::JParser parser;
+        parser.parse(R"({"b": 1, "a": 2, "c": {"z": 1, "y": 2}, "a": 3})");
+        std::string dumped = parser.dump();
+        assert(dumped.find(R"("b": 1)") < dumped.find(R"("a": 3)"));
+        assert(dumped.find(R"("a": 3)") < dumped.find(R"("c": {)"));
+        assert(dumped.find(R"("z": 1)") < dumped.find(R"("y": 2)"));
+        Json::JObject parsed = parser.object();
+        expected = {"b", "a", "c"};
+        assert(parsed.keys() == expected);
+        expected = {"z", "y"};
+        assert(parsed.toObject("c")->keys() == expected);
+        std::cout << " ✓\n";
+
+        std::cout << "All insertion order tests passed!\n";
+    }
+
+    void test6() {
+        std::cout << "\nTest 6: String View Lookups\n";
+        std::cout << "---------------------------\n";
+
+        Json::JObject obj;
+        std::string buffer = "name=value";
+        std::string_view name = std::string_view(buffer).substr(0, 4);
+
+        std::cout << "Testing lookups with string views...";
+        obj.set(name, "value");
+        obj.set("count", 3);
+        assert(obj.valid("name") && obj.valid(name));
+        assert(obj.toString(name) == "value");
+        assert(obj.toInt(std::string_view("count")) == 3);
+        assert(!obj.isNull(name));
+        obj[std::string_view("empty")];
+        assert(obj.isNull("empty"));
+        obj.remove(name);
+        assert(!obj.valid(name) && obj.size() == 2);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing errors name the missing key...";
+        try {
+            (void) obj.toInt(name);
+            assert(false);
+        } catch (const Json::JException::KeyIsNotFoundException& e) {
+            assert(std::string(e.what()) == "The key 'name' is not found in object!");
+        }
+        try {
+            (void) obj.toString("count");
+            assert(false);
+        } catch (const Json::JException::GetBadValueException& e) {
+            assert(std::string(e.what()) == "Can't get value from key 'count'!");
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "Testing setting a value taken from the same object...";
+        for (int i = 0; i < 40; ++i) obj.set("copy" + std::to_string(i), obj.get("count"));
+        assert(obj.size() == 42 && obj.toInt("copy39") == 3);
+        std::cout << " ✓\n";
+
+        std::cout << "All string view lookup tests passed!\n";
+    }
+
+    void test7() {
+        std::cout << "\nTest 7: Copy-on-write Snapshots\n";
+        std::cout << "-------------------------------\n";
+
+        Json::JObject config;
+        Json::JObject &database = config.emplaceObject("database");
+        database.set("host", "primary");
+        database.emplaceArray("ports").pushBack(5432);
+        config.emplaceObject("cache").set("size", 64);
+
+        std::cout << "Testing a snapshot is unaffected by later writes...";
+        Json::JObject snapshot = config;
+        std::get<std::shared_ptr<Json::JObject>>(config["database"])->set("host", "replica");
+        auto &ports = std::get<std::shared_ptr<Json::JArray>>(
+                std::get<std::shared_ptr<Json::JObject>>(config["database"])->get("ports"));
+        (*ports)[0] = 6432;
+        ports->pushBack(6433);
+        config.set("version", 2);
+        assert(config.toObject("database")->toString("host") == "replica");
+        assert(config.toObject("database")->toArray("ports")->size() == 2);
+        assert(snapshot.toObject("database")->toString("host") == "primary");
+        assert(snapshot.toObject("database")->toArray("ports")->toInt(0) == 5432);
+        assert(snapshot.toObject("database")->toArray("ports")->size() == 1);
+        assert(!snapshot.valid("version") && snapshot.size() == 2);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing only the modified path is copied...";
+        assert(snapshot.toObject("cache") == config.toObject("cache"));
+        assert(snapshot.toObject("database") != config.toObject("database"));
+        std::cout << " ✓\n";
+
+        std::cout << "Testing writes through iterators and removal...";
+        Json::JObject copy = snapshot;
+        for (auto [key, value] : copy) {
+            std::get<std::shared_ptr<Json::JObject>>(value)->set("touched", true);
+        }
+        copy.remove("cache");
+        assert(copy.size() == 1 && copy.toObject("database")->toBool("touched"));
+        assert(snapshot.size() == 2 && !snapshot.toObject("cache")->valid("touched"));
+        assert(!snapshot.toObject("database")->valid("touched"));
+        std::cout << " ✓\n";
+
+        std::cout << "Testing copied arrays and values...";
+        Json::JArray list;
+        list << 1 << Json::JObject();
+        Json::JArray list_copy = list;
+        list_copy[0] = 2;
+        std::get<std::shared_ptr<Json::JObject>>(list_copy[1])->set("k", 1);
+        list_copy.sort([](Json::JValue &a, Json::JValue &b) { return a.index() > b.index(); });
+        assert(list.toInt(0) == 1 && list.toObject(1)->size() == 0);
+        assert(list_copy.toObject(0)->toInt("k") == 1 && list_copy.toInt(1) == 2);
+        Json::JValue held = config.get("cache");
+        std::get<std::shared_ptr<Json::JObject>>(config["cache"])->set("size", 128);
+        assert(std::get<std::shared_ptr<Json::JObject>>(held)->toInt("size") == 64);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing references taken before a copy...";
+        Json::JObject settings;
+        Json::JObject &stale = settings.emplaceObject("server");
+        stale.set("port", 80);
+        Json::JObject frozen = settings;
+        // A reference obtained before the copy still reaches the shared child, so it also changes the copy
+        stale.set("port", 81);
+        assert(frozen.toObject("server")->toInt("port") == 81);
+        // Taking the reference again after the copy detaches the child first
+        std::get<std::shared_ptr<Json::JObject>>(settings["server"])->set("port", 8080);
+        assert(settings.toObject("server")->toInt("port") == 8080);
+        assert(frozen.toObject("server")->toInt("port") == 81);
+        std::cout << " ✓\n";
+
+        std::cout << "All copy-on-write tests passed!\n";
+    }
+
+    void test8() {
+        std::cout << "\nTest 8: Snapshots Released on Other Threads\n";
+        std::cout << "-------------------------------------------\n";
+
+        std::cout << "Testing writes after readers drop their snapshots...";
+        Json::JObject config;
+        config.emplaceObject("limits").set("rate", 0);
+        config.emplaceArray("hosts") << "a";
+        for (int round = 1; round <= 200; ++round) {
+            std::atomic<int> mismatches{0};
+            std::vector<std::thread> readers;
+            for (int r = 0; r < 2; ++r) {
+                readers.emplace_back([snapshot = config, round, &mismatches]() mutable {
+                    if (snapshot.toObject("limits")->toInt("rate") != round - 1 ||
+                        snapshot.toArray("hosts")->size() != static_cast<size_t>(round))
+                        mismatches++;
+                    snapshot = Json::JObject();
+                });
+            }
+            // Copies while a reader still holds its snapshot, writes in place once every reader has dropped it
+            std::get<std::shared_ptr<Json::JObject>>(config["limits"])->set("rate", round);
+            std::get<std::shared_ptr<Json::JArray>>(config["hosts"])->pushBack("b");
+            for (auto &reader : readers) reader.join();
+            assert(mismatches == 0);
+        }
+        assert(config.toObject("limits")->toInt("rate") == 200 && config.toArray("hosts")->size() == 201);
+        std::cout << " ✓\n";
+
+        std::cout << "All cross-thread snapshot tests passed!\n";
+    }
+
     int start() {
         std::cout << "======= JObject Test Case =======\n";
         test1();
         test2();
         test3();
         test4();
+        test5();
+        test6();
+        test7();
+        test8();
         std::cout << "=================================\n";
         return 0;
     }
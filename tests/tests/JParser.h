@@ -4,6 +4,10 @@
 #include "../../src/Json.h"
 #include <cassert>
 #include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cmath>
+#include <limits>
 
 namespace Test_Parser {
     void test1() {
@@ -223,12 +227,936 @@ namespace Test_Parser {
         std::cout << "All error handling and edge case tests passed!\n";
     }
 
+    void test5() {
+        std::cout << "\nTest 5: Single-pass and Two-pass Modes\n";
+        std::cout << "------------------------------------\n";
+
+        std::string json = R"({
+            "name": "JsonBuilder",
+            "list": [1, -2, 3.5, "four", [true, false], {"five": null}],
+            "empty_object": {},
+            "empty_array": []
+        })";
+
+        std::cout << "Testing both modes produce the same tree...";
+        Json::JParser single, two;
+        assert(single.parseMode() == Json::JParser::SinglePass);
+        two.setParseMode(Json::JParser::TwoPass);
+        single.parse(json);
+        two.parse(json);
+        assert(single.object().size() == 4);
+        assert(single.object().toString("name") == two.object().toString("name"));
+        const Json::JArray* list = single.object().toArray("list");
+        assert(list->size() == 6);
+        assert(list->toBigInt(1) == -2);
+        assert(list->toDouble(2) == 3.5);
+        assert(list->toArray(4)->toBool(0) == true);
+        assert(list->toObject(5)->isNull("five"));
+        assert(single.dump(2).size() == two.dump(2).size());
+        std::cout << " ✓\n";
+
+        std::cout << "Testing both modes report the same errors...";
+        const char* bad_inputs[] = {
+            "{invalid json}", "[1, 2, 3,]", "{\"a\":1,}", "{\"a\" 1}", "[1 2]", "[1:2]",
+            "{\"a\": }", "{\"a\":tru}", "{\"a\":\"abc}", "{\"a\":1..2}", "{} x", "\"text\""
+        };
+        for (auto input : bad_inputs) {
+            std::string single_error, two_error;
+            try {
+                single.parse(input);
+            } catch (const Json::JException::ParseJsonError& e) {
+                single_error = e.what();
+            }
+            try {
+                two.parse(input);
+            } catch (const Json::JException::ParseJsonError& e) {
+                two_error = e.what();
+            }
+            assert(!single_error.empty());
+            assert(single_error == two_error);
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "Testing unclosed and redundant brackets...";
+        try {
+            single.parse("{\"key\": \"value\"");
+            assert(false);
+        } catch (const Json::JException::ParseJsonError& e) {
+            assert(std::string(e.what()).find("uncompleted object") != std::string::npos);
+        }
+        try {
+            single.parse("[1]\n]");
+            assert(false);
+        } catch (const Json::JException::ParseJsonError& e) {
+            assert(std::string(e.what()) == "Redundant enclosing character ']' at line 2 col 1!");
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "All parse mode tests passed!\n";
+    }
+
+    void test6() {
+        std::cout << "\nTest 6: Structural Index\n";
+        std::cout << "----------------------\n";
+
+        Json::JParser single, two;
+        two.setParseMode(Json::JParser::TwoPass);
+
+        std::cout << "Testing strings across 64-byte blocks...";
+        for (size_t padding = 0; padding < 140; ++padding) {
+            std::string text = std::string(padding, 'x') + "{[\\\"]}, \\\\:" + std::string(padding % 7, ' ');
+            std::string json = "[\"" + text + "\", {\"key\": \"" + text + "\"}, " + std::to_string(padding) + "]";
+            single.parse(json);
+            two.parse(json);
+            assert(two.array().size() == 3);
+            assert(two.array().toString(0) == single.array().toString(0));
+            assert(two.array().toString(0).find("{[\"]}, \\:") == padding);
+            assert(two.array().toObject(1)->toString("key") == single.array().toString(0));
+            assert(two.array().toBigInt(2) == static_cast<int64_t>(padding));
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "Testing escaped quotes and backslash runs...";
+        two.parse(R"({"a": "say \"hi\"", "b": "\\", "c": "\\\"", "d": [1,2]})");
+        assert(two.object().toString("a") == "say \"hi\"");
+        assert(two.object().toString("b") == "\\");
+        assert(two.object().toString("c") == "\\\"");
+        assert(two.object().toArray("d")->size() == 2);
+        single.parse(R"({"a": "say \"hi\""})");
+        assert(single.object().toString("a") == "say \"hi\"");
+        std::cout << " ✓\n";
+
+        std::cout << "Testing errors found through the index...";
+        const char* bad_inputs[] = {
+            "[\"abc\\\"]", "[\"line\nbreak\"]", "[truex]", "[1a]", "[\"a\"b]", "[1 \\ 2]", "[nul]"
+        };
+        for (auto input : bad_inputs) {
+            std::string single_error, two_error;
+            try {
+                single.parse(input);
+            } catch (const Json::JException::ParseJsonError& e) {
+                single_error = e.what();
+            }
+            try {
+                two.parse(input);
+            } catch (const Json::JException::ParseJsonError& e) {
+                two_error = e.what();
+            }
+            assert(!two_error.empty());
+            assert(single_error == two_error);
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "All structural index tests passed!\n";
+    }
+
+    /// 记录所有事件的 Handler，stop_after 个事件后返回 false
+    class EventRecorder : public Json::JHandler {
+    public:
+        explicit EventRecorder(size_t stop_after = SIZE_MAX) : _stop_after(stop_after) {}
+
+        bool onNull() override { return record("null"); }
+        bool onBool(bool value) override { return record(value ? "true" : "false"); }
+        bool onInt64(int64_t value) override { return record("int:" + std::to_string(value)); }
+        bool onDouble(double value) override { return record("double:" + std::to_string(value)); }
+        bool onString(std::string_view value) override { return record("string:" + std::string(value)); }
+        bool onKey(std::string_view key) override { return record("key:" + std::string(key)); }
+        bool onStartObject() override { return record("{"); }
+        bool onEndObject() override { return record("}"); }
+        bool onStartArray() override { return record("["); }
+        bool onEndArray() override { return record("]"); }
+
+        std::vector<std::string> events;
+    private:
+        bool record(std::string event) {
+            events.push_back(std::move(event));
+            return events.size() < _stop_after;
+        }
+
+        size_t _stop_after;
+    };
+
+    void test7() {
+        std::cout << "\nTest 7: Event Handler\n";
+        std::cout << "---------------------\n";
+
+        std::string json = R"({"id": 7, "tags": ["a\tb", true, null], "score": -1.5, "child": {}})";
+
+        std::cout << "Testing events are delivered in document order...";
+        EventRecorder recorder;
+        assert(Json::JParser::parse(json, recorder));
+        std::vector<std::string> expected = {
+            "{", "key:id", "int:7", "key:tags", "[", "string:a\tb", "true", "null", "]",
+            "key:score", "double:-1.500000", "key:child", "{", "}", "}"
+        };
+        assert(recorder.events == expected);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing a handler can stop parsing early...";
+        EventRecorder stopper(4);
+        assert(!Json::JParser::parse(json + " trailing garbage", stopper));
+        assert(stopper.events.size() == 4);
+        assert(stopper.events.back() == "key:tags");
+        std::cout << " ✓\n";
+
+        std::cout << "Testing the default handler ignores every event...";
+        Json::JHandler ignore;
+        assert(Json::JParser::parse(json, ignore));
+        assert(Json::JParser::parse("  ", ignore));
+        std::cout << " ✓\n";
+
+        std::cout << "Testing handler and tree parsing report the same errors...";
+        const char* bad_inputs[] = {
+            "{invalid json}", "[1, 2, 3,]", "{\"a\":1,}", "[1 2]", "{\"a\":tru}", "{} x", "\"text\""
+        };
+        Json::JParser parser;
+        for (auto input : bad_inputs) {
+            std::string tree_error, handler_error;
+            try {
+                parser.parse(input);
+            } catch (const Json::JException::ParseJsonError& e) {
+                tree_error = e.what();
+            }
+            try {
+                Json::JParser::parse(input, ignore);
+            } catch (const Json::JException::ParseJsonError& e) {
+                handler_error = e.what();
+            }
+            assert(!tree_error.empty());
+            assert(tree_error == handler_error);
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "All event handler tests passed!\n";
+    }
+
+    void test8() {
+        std::cout << "\nTest 8: Incremental Stream Parser\n";
+        std::cout << "---------------------------------\n";
+
+        std::string json = R"({"text": "a\"b\\c", "number": -12.75, "list": [true, null, 123456789012], "o": {}})";
+        EventRecorder whole;
+        Json::JParser::parse(json, whole);
+
+        std::cout << "Testing every split point gives the same events...";
+        for (size_t split = 0; split <= json.size(); ++split) {
+            EventRecorder recorder;
+            Json::JStreamParser stream(recorder);
+            assert(stream.feed(json.data(), split));
+            assert(stream.complete() == (split == 0 || split == json.size()));
+            assert(stream.feed(json.data() + split, json.size() - split));
+            assert(stream.complete());
+            stream.finish();
+            assert(recorder.events == whole.events);
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "Testing one byte at a time...";
+        EventRecorder bytes;
+        Json::JStreamParser byte_stream(bytes);
+        for (char c : json) byte_stream.feed(&c, 1);
+        byte_stream.finish();
+        assert(bytes.events == whole.events);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing concatenated documents...";
+        EventRecorder many;
+        Json::JStreamParser many_stream(many);
+        many_stream.feed("[1]{\"a\"");
+        assert(many_stream.documents() == 1);
+        assert(!many_stream.complete());
+        many_stream.feed(": 2}\n[]");
+        assert(many_stream.documents() == 3);
+        assert(many_stream.complete());
+        many_stream.finish();
+        assert(many_stream.documents() == 3);
+        std::vector<std::string> expected = {"[", "int:1", "]", "{", "key:a", "int:2", "}", "[", "]"};
+        assert(many.events == expected);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing a handler can stop the stream...";
+        EventRecorder stopper(2);
+        Json::JStreamParser stop_stream(stopper);
+        assert(!stop_stream.feed("[1, 2, 3]"));
+        assert(!stop_stream.feed("[4]"));
+        assert(stopper.events.size() == 2);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing errors across chunks...";
+        Json::JHandler ignore;
+        Json::JStreamParser error_stream(ignore);
+        try {
+            error_stream.feed("{\"a\": [1,\n");
+            error_stream.feed(" 2,]}");
+            assert(false);
+        } catch (const Json::JException::ParseJsonError& e) {
+            assert(std::string(e.what()) == "The Array is not completed at line 2 col 3!");
+        }
+        error_stream.reset();
+        try {
+            error_stream.feed("{\"a\": \"unterminated");
+            error_stream.finish();
+            assert(false);
+        } catch (const Json::JException::ParseJsonError& e) {
+            assert(std::string(e.what()) == "The character '\"' is not enclosed at line 1 col 7!");
+        }
+        error_stream.reset();
+        try {
+            error_stream.feed("[1, 2");
+            error_stream.finish();
+            assert(false);
+        } catch (const Json::JException::ParseJsonError& e) {
+            assert(std::string(e.what()).find("uncompleted array") != std::string::npos);
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "All stream parser tests passed!\n";
+    }
+
+    void test9() {
+        std::cout << "\nTest 9: JSON Lines\n";
+        std::cout << "------------------\n";
+
+        std::string text;
+        for (int i = 0; i < 20000; ++i) {
+            if (i % 1000 == 999) {
+                text += "{\"id\": " + std::to_string(i) + ",}\n";
+            } else if (i % 500 == 0) {
+                text += "\r\n";
+            } else {
+                text += "{\"id\": " + std::to_string(i) + ", \"tags\": [\"x\", " + std::to_string(i % 7) + "]}\n";
+            }
+        }
+        text += "[1, 2, 3]";
+
+        std::cout << "Testing lines are delivered in order...";
+        Json::JLinesParser parser(4);
+        assert(parser.threads() == 4);
+        assert(parser.ordered());
+        size_t expected_number = 1, errors = 0;
+        parser.parse(text, [&](Json::JLine& line) {
+            while (expected_number % 500 == 1 && expected_number <= 20000) expected_number++;
+            assert(line.number == expected_number++);
+            if (!line.error.empty()) {
+                errors++;
+                assert(line.number % 1000 == 0);
+                assert(line.error.find("The Object is not completed") != std::string::npos);
+            } else if (line.number <= 20000) {
+                assert(line.document.object().toBigInt("id") == static_cast<int64_t>(line.number - 1));
+            } else {
+                assert(line.document.array().size() == 3);
+            }
+        });
+        assert(expected_number == 20002);
+        assert(errors == 20);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing unordered delivery sees every line once...";
+        parser.setOrdered(false);
+        std::vector<bool> seen(20002, false);
+        parser.parse(text, [&](Json::JLine& line) {
+            assert(!seen[line.number]);
+            seen[line.number] = true;
+        });
+        assert(std::count(seen.begin(), seen.end(), true) == 20000 - 40 + 1);
+        std::vector<Json::JLine> lines = parser.parse(text);
+        assert(lines.size() == 20000 - 40 + 1);
+        assert(std::is_sorted(lines.begin(), lines.end(), [](const Json::JLine& a, const Json::JLine& b) {
+            return a.number < b.number;
+        }));
+        std::cout << " ✓\n";
+
+        std::cout << "Testing a single thread gives the same results...";
+        Json::JLinesParser single(1);
+        std::vector<Json::JLine> single_lines = single.parse(text);
+        assert(single_lines.size() == lines.size());
+        for (size_t i = 0; i < lines.size(); ++i) {
+            assert(single_lines[i].number == lines[i].number);
+            assert(single_lines[i].error == lines[i].error);
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "All JSON Lines tests passed!\n";
+    }
+
+    void test10() {
+        std::cout << "\nTest 10: Parallel Array Parsing\n";
+        std::cout << "-------------------------------\n";
+
+        std::string json = "[\n";
+        for (int i = 0; i < 20000; ++i) {
+            json += "  {\"id\": " + std::to_string(i) + ", \"text\": \"a, [b] {c} \\\"d,\\\" e\\\\\", " +
+                    "\"list\": [" + std::to_string(i) + ", [\"]\", \",\"], {}]}";
+            json += (i + 1 < 20000) ? ",\n" : "\n";
+        }
+        json += "]\n";
+
+        std::cout << "Testing the parallel result matches the single-threaded one...";
+        Json::JParser single, parallel;
+        parallel.setThreads(4);
+        assert(parallel.threads() == 4);
+        single.parse(json);
+        parallel.parse(json);
+        assert(parallel.array().size() == 20000);
+        for (size_t i = 0; i < 20000; i += 997) {
+            const Json::JObject* object = parallel.array().toObject(i);
+            assert(object->toBigInt("id") == static_cast<int64_t>(i));
+            assert(object->toString("text") == "a, [b] {c} \"d,\" e\\");
+        }
+        assert(parallel.dump(2) == single.dump(2));
+        std::cout << " ✓\n";
+
+        std::cout << "Testing errors match the single-threaded parser...";
+        std::string bad_inputs[] = {
+            json.substr(0, json.size() - 3) + ",]",
+            json + "x",
+            json.substr(0, json.size() / 2) + "tru" + json.substr(json.size() / 2),
+            json.substr(0, json.size() - 2)
+        };
+        for (auto& input : bad_inputs) {
+            std::string single_error, parallel_error;
+            try {
+                single.parse(input);
+            } catch (const Json::JException::ParseJsonError& e) {
+                single_error = e.what();
+            }
+            try {
+                parallel.parse(input);
+            } catch (const Json::JException::ParseJsonError& e) {
+                parallel_error = e.what();
+            }
+            assert(!single_error.empty());
+            assert(single_error == parallel_error);
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "All parallel array tests passed!\n";
+    }
+
+    void test11() {
+        std::cout << "\nTest 11: Mapped File Input\n";
+        std::cout << "--------------------------\n";
+
+        std::string test_file = "test_mapped_file.json";
+        std::string long_text(100000, 'x');
+
+        std::cout << "Testing lines longer than max_cols_inline...";
+        {
+            std::ofstream file(test_file, std::ios::out | std::ios::binary);
+            file << "{\"long\": \"" << long_text << "\",\r\n \"list\": [1, 2, 3]}";
+        }
+        Json::JParser parser;
+        assert(parser.parseFromJsonFile(test_file, 16));
+        assert(parser.object().toString("long") == long_text);
+        assert(parser.object().toArray("list")->size() == 3);
+        Json::JParser constructed(test_file);
+        assert(constructed.object().toString("long") == long_text);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing an empty file...";
+        {
+            std::ofstream file(test_file, std::ios::out | std::ios::trunc);
+        }
+        Json::JParser empty;
+        assert(empty.parseFromJsonFile(test_file));
+        assert(empty.object().size() == 0 && empty.array().size() == 0);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing JSON Lines from a file...";
+        {
+            std::ofstream file(test_file, std::ios::out | std::ios::trunc);
+            file << "{\"a\": 1}\n{\"a\": 2}\n[\"" << long_text << "\"]\n";
+        }
+        Json::JLinesParser lines(2);
+        size_t count = 0;
+        assert(lines.parseFromFile(test_file, [&count](Json::JLine& line) {
+            assert(line.error.empty());
+            count++;
+        }));
+        assert(count == 3);
+        assert(!lines.parseFromFile("non_existent_file.jsonl", [](Json::JLine&) {}));
+        std::cout << " ✓\n";
+
+        remove(test_file.c_str());
+        std::cout << "All mapped file tests passed!\n";
+    }
+
+    void test12() {
+        std::cout << "\nTest 12: Number Parsing\n";
+        std::cout << "-----------------------\n";
+
+        std::string json = R"([0, -7, 2147483647, 2147483648, -2147483649, 9223372036854775807,
+                               18446744073709551616, 1e3, -2.5E-3, 0.1, 1E+2, 6.02214076e23, 1e-400])";
+
+        std::cout << "Testing integers use the narrowest type...";
+        Json::JParser single, two;
+        two.setParseMode(Json::JParser::TwoPass);
+        single.parse(json);
+        two.parse(json);
+        for (const Json::JParser* parser : {&single, &two}) {
+            const Json::JArray& array = parser->array();
+            assert(Json::JGet::isInt(array.get(0)) && array.toInt(0) == 0);
+            assert(Json::JGet::isInt(array.get(1)) && array.toInt(1) == -7);
+            assert(Json::JGet::isInt(array.get(2)) && array.toInt(2) == 2147483647);
+            assert(Json::JGet::isBigInt(array.get(3)) && array.toBigInt(3) == 2147483648LL);
+            assert(Json::JGet::isBigInt(array.get(4)) && array.toBigInt(4) == -2147483649LL);
+            assert(array.toBigInt(5) == INT64_MAX);
+            assert(Json::JGet::isDouble(array.get(6)) && array.toDouble(6) == 18446744073709551616.0);
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "Testing fractions and exponents...";
+        for (const Json::JParser* parser : {&single, &two}) {
+            const Json::JArray& array = parser->array();
+            assert(Json::JGet::isDouble(array.get(7)) && array.toDouble(7) == 1000.0);
+            assert(array.toDouble(8) == -2.5e-3);
+            assert(array.toDouble(9) == 0.1);
+            assert(array.toDouble(10) == 100.0);
+            assert(array.toDouble(11) == 6.02214076e23);
+            assert(array.toDouble(12) == 0.0);
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "Testing malformed numbers...";
+        std::pair<const char*, const char*> bad_inputs[] = {
+            {"[01]", "The number can not start with the digit '0' at line 1 col 2!"},
+            {"[1.]", "Can't parse number '1.' at line 1 col 2!"},
+            {"[1e+]", "Can't parse number '1e+' at line 1 col 2!"},
+            {"[1..2]", "The number is not allowed to have repeated '.' characters at line 1 col 4!"},
+            {"[--1]", "The number is not allowed to have repeated '-' characters at line 1 col 3!"},
+            {"[1e400]", "Can't parse number '1e400' at line 1 col 2!"}
+        };
+        for (auto& [input, message] : bad_inputs) {
+            for (Json::JParser* parser : {&single, &two}) {
+                try {
+                    parser->parse(input);
+                    assert(false);
+                } catch (const Json::JException::ParseJsonError& e) {
+                    assert(std::string(e.what()) == message);
+                }
+            }
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "All number parsing tests passed!\n";
+    }
+
+    void test13() {
+        std::cout << "\nTest 13: String Escapes\n";
+        std::cout << "-----------------------\n";
+
+        std::string long_text(100, 'x');
+        std::string json = R"(["caf\u00e9", "\ud83d\ude00", "a\"b\\c\/d", "it\'s", "\ud800!", ")" +
+                           long_text + R"(\n", "\u4e2d\u6587"])";
+
+        std::cout << "Testing \\u escapes and surrogate pairs become UTF-8...";
+        Json::JParser single, two;
+        two.setParseMode(Json::JParser::TwoPass);
+        single.parse(json);
+        two.parse(json);
+        for (const Json::JParser* parser : {&single, &two}) {
+            const Json::JArray& array = parser->array();
+            assert(array.toString(0) == "caf\xC3\xA9");
+            assert(array.toString(1) == "\xF0\x9F\x98\x80");
+            assert(array.toString(4) == "\xEF\xBF\xBD!");
+            assert(array.toString(6) == "\xE4\xB8\xAD\xE6\x96\x87");
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "Testing simple escapes and long strings...";
+        for (const Json::JParser* parser : {&single, &two}) {
+            const Json::JArray& array = parser->array();
+            assert(array.toString(2) == "a\"b\\c/d");
+            assert(array.toString(3) == "it's");
+            assert(array.toString(5) == long_text + "\n");
+        }
+        assert(Json::strToEscape(R"(a\tb\u0041)") == "a\tbA");
+        std::cout << " ✓\n";
+
+        std::cout << "Testing the stream parser decodes across chunks...";
+        for (size_t split = 0; split <= json.size(); split += 3) {
+            EventRecorder events;
+            Json::JStreamParser stream(events);
+            stream.feed(std::string_view(json).substr(0, split));
+            stream.feed(std::string_view(json).substr(split));
+            stream.finish();
+            assert(events.events[1] == "string:caf\xC3\xA9");
+            assert(events.events[2] == "string:\xF0\x9F\x98\x80");
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "Testing invalid \\u escapes...";
+        for (Json::JParser* parser : {&single, &two}) {
+            try {
+                parser->parse(R"(["ok", "\u12G4"])");
+                assert(false);
+            } catch (const Json::JException::ParseJsonError& e) {
+                assert(std::string(e.what()) == "The unicode escape sequence is invalid at line 1 col 9!");
+            }
+        }
+        try {
+            EventRecorder events;
+            Json::JStreamParser stream(events);
+            stream.feed(R"(["ok", "\u12G4"])");
+            assert(false);
+        } catch (const Json::JException::ParseJsonError& e) {
+            assert(std::string(e.what()) == "The unicode escape sequence is invalid at line 1 col 9!");
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "All string escape tests passed!\n";
+    }
+
+    class ViewCollector : public Json::JHandler {
+    public:
+        bool onString(std::string_view value) override {
+            views.push_back(value);
+            return true;
+        }
+        bool onKey(std::string_view key) override {
+            views.push_back(key);
+            return true;
+        }
+
+        std::vector<std::string_view> views;
+    };
+
+    void test14() {
+        std::cout << "\nTest 14: In-situ Parsing\n";
+        std::cout << "------------------------\n";
+
+        std::string json = R"({"name": "a\"b", "list": ["x\ny", "\u00e9t\u00e9", 12, "plain"], "ok": true})";
+
+        std::cout << "Testing documents borrow every string from the buffer...";
+        Json::JParser expected;
+        expected.parse(json);
+        std::vector<char> buffer(json.begin(), json.end());
+        Json::JDocument document;
+        document.parseInSitu(buffer.data(), buffer.size());
+        assert(Json::JParser::dump(document.root()) == expected.dump());
+        assert(std::string(buffer.data(), buffer.size()) != json);
+        auto inside = [&buffer](std::string_view text) {
+            return text.data() >= buffer.data() && text.data() + text.size() <= buffer.data() + buffer.size();
+        };
+        assert(Json::JGet::toString(document.root().get("name")) == "a\"b");
+        assert(inside(Json::JGet::toString(document.root().get("name"))));
+        assert(inside(Json::JGet::toString(document.root().get("list").at(1))));
+        assert(inside(Json::JGet::toString(document.root().members()[2].key)));
+        Json::JNode copy = document.root();
+        document.clear();
+        assert(Json::JGet::toString(copy.get("list").at(0)) == "x\ny");
+        std::cout << " ✓\n";
+
+        std::cout << "Testing strings point into the buffer after parsing...";
+        buffer.assign(json.begin(), json.end());
+        ViewCollector collector;
+        bool completed = Json::JParser::parseInSitu(buffer.data(), buffer.size(), collector);
+        assert(completed);
+        std::vector<std::string> strings{"name", "a\"b", "list", "x\ny", "\xC3\xA9t\xC3\xA9", "plain", "ok"};
+        assert(collector.views.size() == strings.size());
+        for (size_t i = 0; i < strings.size(); ++i) {
+            assert(collector.views[i] == strings[i]);
+            assert(collector.views[i].data() >= buffer.data() &&
+                   collector.views[i].data() + collector.views[i].size() <= buffer.data() + buffer.size());
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "Testing errors after decoded newlines keep the original position...";
+        std::string bad = "[\"a\\nb\\nc\", \n \"d\" \"e\"]";
+        buffer.assign(bad.begin(), bad.end());
+        try {
+            document.parseInSitu(buffer.data(), buffer.size());
+            assert(false);
+        } catch (const Json::JException::ParseJsonError& e) {
+            try {
+                expected.parse(bad);
+                assert(false);
+            } catch (const Json::JException::ParseJsonError& original) {
+                assert(std::string(e.what()) == original.what());
+            }
+            assert(Json::JGet::isNull(document.root()));
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "All in-situ parsing tests passed!\n";
+    }
+
+    void test15() {
+        std::cout << "\nTest 15: Streaming Writer\n";
+        std::cout << "-------------------------\n";
+
+        Json::JObject root;
+        Json::JArray &rows = root.emplaceArray("rows");
+        for (int i = 0; i < 50; ++i) {
+            Json::JObject &row = rows.emplaceObject();
+            row.set("id", i);
+            row.set("name", "row \"" + std::to_string(i) + "\"");
+            row.emplaceArray("tags") << "a" << 1.5 << true << Json::JValue();
+        }
+        root.set("empty", Json::JObject());
+        Json::JParser parser(root);
+        const std::string expected = parser.dump(2);
+
+        std::cout << "Testing writing into a string...";
+        std::string output = "prefix:";
+        {
+            Json::JWriter writer(output, 2);
+            writer.write(root);
+        }
+        assert(output == "prefix:" + expected);
+        std::string scalar;
+        Json::JWriter(scalar).write(Json::JValue("x\ty"));
+        assert(scalar == "\"x\\ty\"");
+        std::cout << " ✓\n";
+
+        std::cout << "Testing chunks are flushed to a callback as the buffer fills...";
+        std::vector<std::string> chunks;
+        {
+            Json::JWriter writer([&](std::string_view chunk) { chunks.emplace_back(chunk); }, 2, 256);
+            parser.dump(writer);
+            assert(!chunks.empty());
+        }
+        std::string joined;
+        size_t largest = 0;
+        for (auto &chunk : chunks) {
+            joined += chunk;
+            largest = std::max(largest, chunk.size());
+        }
+        assert(joined == expected);
+        assert(chunks.size() > 10 && largest < 512);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing streams, file descriptors and compact nodes...";
+        std::ostringstream stream;
+        {
+            Json::JWriter writer(stream, 4);
+            writer.write(root);
+            writer.flush();
+        }
+        assert(stream.str() == parser.dump(4));
+        Json::JNode node = Json::JParser::parseNode(expected);
+        std::ostringstream node_stream;
+        Json::JWriter(node_stream, 2).write(node);
+        assert(node_stream.str() == expected);
+#if defined(__unix__) || defined(__APPLE__)
+        std::string test_file = "test_json_writer.json";
+        FILE *file = fopen(test_file.c_str(), "w");
+        assert(file);
+        {
+            Json::JWriter writer(fileno(file), 2, 128);
+            writer.write(root);
+        }
+        fclose(file);
+        Json::JParser reread;
+        bool loaded = reread.parseFromJsonFile(test_file);
+        assert(loaded && reread.dump(2) == expected);
+        remove(test_file.c_str());
+#endif
+        std::cout << " ✓\n";
+
+        std::cout << "All streaming writer tests passed!\n";
+    }
+
+    void test16() {
+        std::cout << "\nTest 16: Compact Output\n";
+        std::cout << "-----------------------\n";
+
+        std::string json = R"({"name": "a b", "list": [1, 2.5, "x\ny", [], {}], "nested": {"ok": true, "none": null}})";
+
+        std::cout << "Testing dump(0) has no whitespace...";
+        Json::JParser parser;
+        parser.parse(json);
+        const std::string compact = parser.dump(0);
+        assert(compact == R"({"name":"a b","list":[1,2.5,"x\ny",[],{}],"nested":{"ok":true,"none":null}})");
+        Json::JParser reparsed;
+        reparsed.parse(compact);
+        assert(reparsed.dump(2) == parser.dump(2));
+        std::cout << " ✓\n";
+
+        std::cout << "Testing compact nodes and packed arrays...";
+        assert(Json::JParser::dump(Json::JParser::parseNode(json), 0) == compact);
+        Json::JParser numbers;
+        numbers.parse("[1, 2, 3, 4, 5, 6, 7, 8, 9]");
+        assert(!numbers.array().integers().empty());
+        assert(numbers.dump(0) == "[1,2,3,4,5,6,7,8,9]");
+        std::string streamed;
+        Json::JWriter(streamed, 0).write(Json::JObject());
+        assert(streamed == "{}");
+        std::cout << " ✓\n";
+
+        std::cout << "All compact output tests passed!\n";
+    }
+
+    void test17() {
+        std::cout << "\nTest 17: Number Formatting\n";
+        std::cout << "--------------------------\n";
+
+        std::cout << "Testing shortest round-trip output...";
+        Json::JArray numbers;
+        numbers << 1e-9 << 0.1 << 3.14159265358979 << 1e21 << -2.5 << 5e-324 << 0.1f << 42 << int64_t(-9007199254740993);
+        Json::JParser parser(numbers);
+        assert(parser.dump(0) == "[1e-09,0.1,3.14159265358979,1e+21,-2.5,5e-324,0.1,42,-9007199254740993]");
+        Json::JParser reparsed;
+        reparsed.parse(parser.dump(0));
+        for (size_t i = 0; i < 6; ++i) assert(reparsed.array().toDouble(i) == numbers.toDouble(i));
+        std::cout << " ✓\n";
+
+        std::cout << "Testing integral doubles stay doubles...";
+        Json::JArray integral;
+        integral << 1.0 << -0.0 << 100.0 << 2.0f;
+        Json::JParser integral_parser(integral);
+        assert(integral_parser.dump(0) == "[1.0,-0.0,100.0,2.0]");
+        reparsed.parse(integral_parser.dump(0));
+        assert(reparsed.array().get(0).index() == Json::JDataType::Double);
+        assert(std::signbit(reparsed.array().toDouble(1)));
+        std::cout << " ✓\n";
+
+        std::cout << "Testing non-finite values become null...";
+        Json::JObject special;
+        special.set("nan", std::nan(""));
+        special.set("inf", std::numeric_limits<double>::infinity());
+        Json::JParser special_parser(special);
+        assert(special_parser.dump(0) == R"({"nan":null,"inf":null})");
+        assert(Json::JParser::dump(Json::JNode(special), 0) == special_parser.dump(0));
+        std::cout << " ✓\n";
+
+        std::cout << "All number formatting tests passed!\n";
+    }
+
+    void test18() {
+        std::cout << "\nTest 18: String Escaping\n";
+        std::cout << "------------------------\n";
+
+        std::cout << "Testing control characters and quotes...";
+        Json::JObject obj;
+        obj.set("text", std::string("a\x01" "b\x1f" "c'\"\\\n\t"));
+        Json::JParser parser(obj);
+        assert(parser.dump(0) == R"({"text":"a\u0001b\u001fc'\"\\\n\t"})");
+        assert(Json::escToString("it's") == "it's");
+        std::cout << " ✓\n";
+
+        std::cout << "Testing escaped keys round-trip...";
+        std::string json = R"({"a\"b": 1, "tab\tkey": {"é": [true]}, "plain": "x"})";
+        Json::JParser single;
+        single.parse(json);
+        const auto keys = single.object().keys();
+        assert(keys[0] == "a\"b" && keys[1] == "tab\tkey");
+        const std::string compact = single.dump(0);
+        assert(compact.find(R"("a\"b":1)") != std::string::npos);
+        Json::JParser two;
+        two.setParseMode(Json::JParser::TwoPass);
+        two.parse(compact);
+        assert(two.dump(0) == compact);
+        std::string buffer = compact;
+        Json::JDocument in_situ;
+        in_situ.parseInSitu(buffer.data(), buffer.size());
+        assert(Json::JParser::dump(in_situ.root(), 0) == compact);
+        assert(Json::JParser::dump(Json::JParser::parseNode(compact), 0) == compact);
+        EventRecorder whole;
+        Json::JParser::parse(compact, whole);
+        EventRecorder bytes;
+        Json::JStreamParser stream(bytes);
+        for (char c : compact) stream.feed(&c, 1);
+        stream.finish();
+        assert(bytes.events == whole.events);
+        std::cout << " ✓\n";
+
+        std::cout << "Testing long strings with escapes at block edges...";
+        for (size_t length : {15, 16, 31, 32, 33, 100}) {
+            for (size_t at = 0; at < length; at += 7) {
+                std::string value(length, 'x');
+                value[at] = '\n';
+                std::string expected = "\"" + std::string(at, 'x') + "\\n" + std::string(length - at - 1, 'x') + "\"";
+                Json::JArray array;
+                array << value;
+                Json::JParser writer(array);
+                assert(writer.dump(0) == "[" + expected + "]");
+            }
+        }
+        std::cout << " ✓\n";
+
+        std::cout << "All string escaping tests passed!\n";
+    }
+
+    void test19() {
+        std::cout << "\nTest 19: Parallel Serialization\n";
+        std::cout << "-------------------------------\n";
+
+        Json::JArray records;
+        for (int i = 0; i < 20000; ++i) {
+            Json::JObject record;
+            record.set("id", i);
+            record.set("name", "user \"" + std::to_string(i) + "\"");
+            record.set("score", i * 0.25);
+            if (i % 1000 == 0) record.set("tags", Json::JArray());
+            records << record;
+        }
+        Json::JObject index;
+        for (int i = 0; i < 17000; ++i) index.set("key" + std::to_string(i), i % 3 == 0);
+        std::string number_json = "[0";
+        for (int i = 1; i < 40000; ++i) number_json += "," + std::to_string(i * 37);
+        Json::JParser number_parser;
+        number_parser.parse(number_json + "]");
+        const Json::JArray &numbers = number_parser.array();
+        assert(numbers.integers().size() == 40000);
+
+        std::cout << "Testing output matches the single-threaded dump...";
+        Json::JObject root;
+        root.set("records", records);
+        root.set("index", index);
+        Json::JParser serial(root);
+        Json::JParser parallel(root);
+        parallel.setThreads(4);
+        for (uint8_t space : {0, 2}) assert(parallel.dump(space) == serial.dump(space));
+        Json::JParser serial_array(records);
+        Json::JParser parallel_array(records);
+        parallel_array.setThreads(3);
+        assert(parallel_array.dump(0) == serial_array.dump(0));
+        std::cout << " ✓\n";
+
+        std::cout << "Testing packed arrays, nodes and streaming sinks...";
+        std::string expected, actual;
+        Json::JWriter(expected, 0).write(numbers);
+        Json::JWriter packed_writer(actual, 0);
+        packed_writer.setThreads(4);
+        packed_writer.write(numbers);
+        assert(actual == expected);
+        const std::string compact = serial.dump(0);
+        Json::JNode node = Json::JParser::parseNode(compact);
+        std::string chunks;
+        {
+            Json::JWriter writer([&chunks](std::string_view data) { chunks += data; }, 0, 4096);
+            writer.setThreads(4);
+            assert(writer.threads() == 4);
+            writer.write(node);
+        }
+        assert(chunks == compact);
+        std::cout << " ✓\n";
+
+        std::cout << "All parallel serialization tests passed!\n";
+    }
+
     int start() {
         std::cout << "======= JParser Test Case =======\n";
         test1();
         test2();
         test3();
         test4();
+        test5();
+        test6();
+        test7();
+        test8();
+        test9();
+        test10();
+        test11();
+        test12();
+        test13();
+        test14();
+        test15();
+        test16();
+        test17();
+        test18();
+        test19();
         std::cout << "=================================\n";
         return 0;
     }
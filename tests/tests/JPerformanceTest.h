@@ -3,11 +3,148 @@
 #define JSONBUILDER_JPERFORMANCETEST_H
 #include "../../src/Json.h"
 #include <cassert>
+#include <cmath>
 #include <chrono>
 #include <string>
 #include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <random>
+#include <new>
+#include <thread>
+#include <functional>
+#include <vector>
 
 namespace Test_Performance {
+    // Heap usage tracking for the memory comparisons below
+    namespace Memory {
+        inline std::atomic<size_t> current{0};
+        inline std::atomic<size_t> peak{0};
+        inline std::atomic<size_t> allocations{0};
+
+        inline void resetPeak() {
+            peak = current.load();
+        }
+
+        inline size_t peakSinceReset(size_t baseline) {
+            return peak.load() - baseline;
+        }
+    }
+}
+
+void* operator new(size_t size) {
+    auto* block = static_cast<size_t*>(std::malloc(size + sizeof(std::max_align_t)));
+    if (!block) throw std::bad_alloc();
+    *block = size;
+    Test_Performance::Memory::allocations++;
+    size_t now = Test_Performance::Memory::current += size;
+    size_t peak = Test_Performance::Memory::peak.load();
+    while (now > peak && !Test_Performance::Memory::peak.compare_exchange_weak(peak, now)) {}
+    return reinterpret_cast<char*>(block) + sizeof(std::max_align_t);
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr) return;
+    auto* block = reinterpret_cast<size_t*>(static_cast<char*>(ptr) - sizeof(std::max_align_t));
+    Test_Performance::Memory::current -= *block;
+    std::free(block);
+}
+
+void operator delete[](void* ptr) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+namespace Test_Performance {
+    // Runs measure(threads), which returns the elapsed seconds, for 1, 2, 4, ... threads up to the core count.
+    // Prints throughput, speedup over one thread and efficiency (speedup per thread) so that scaling can be
+    // judged on the host running the tests; each count keeps the best of three runs
+    void reportScaling(size_t bytes, const std::function<double(size_t)> &measure) {
+        size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<size_t> counts;
+        for (size_t threads = 1; threads < hardware; threads *= 2) counts.push_back(threads);
+        counts.push_back(hardware);
+        double single_speed = 0;
+        for (size_t threads : counts) {
+            double seconds = measure(threads);
+            for (int run = 1; run < 3; ++run) seconds = std::min(seconds, measure(threads));
+            double speed = static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds;
+            if (threads == 1) single_speed = speed;
+            double speedup = speed / single_speed;
+            std::cout << threads << " thread(s): " << speed << " MiB/s, speedup " << speedup << "x, efficiency "
+                      << speedup / static_cast<double>(threads) * 100 << "%\n" << std::flush;
+        }
+    }
+
+    std::string makeRecords(size_t count) {
+        std::string json = "[\n";
+        for (size_t i = 0; i < count; ++i) {
+            json += "  {\"id\": " + std::to_string(i) + ", \"name\": \"record_" + std::to_string(i) +
+                    "\", \"score\": " + std::to_string(i % 100) + ".5, \"active\": " +
+                    (i % 2 ? "true" : "false") + ", \"tags\": [\"a\", \"b\", null]}";
+            json += (i + 1 < count) ? ",\n" : "\n";
+        }
+        json += "]";
+        return json;
+    }
+
+    size_t countTokens(const std::string& json) {
+        size_t tokens = 0;
+        bool in_string = false, in_scalar = false;
+        for (char c : json) {
+            if (in_string) {
+                if (c == '"') in_string = false;
+                continue;
+            }
+            bool delimiter = (c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == ',' || c == ':' ||
+                              c == '{' || c == '}' || c == '[' || c == ']' || c == '"');
+            if (delimiter) in_scalar = false;
+            if (c == '"') {
+                in_string = true;
+                tokens++;
+            } else if (c == ',' || c == ':' || c == '{' || c == '}' || c == '[' || c == ']') {
+                tokens++;
+            } else if (!delimiter && !in_scalar) {
+                in_scalar = true;
+                tokens++;
+            }
+        }
+        return tokens;
+    }
+
+    struct ParseReport {
+        double mb_per_sec;
+        size_t peak_bytes;
+    };
+
+    ParseReport measureParse(const std::string& json, Json::JParser::ParseMode mode) {
+        Json::JParser parser;
+        parser.setParseMode(mode);
+        size_t baseline = Memory::current.load();
+        Memory::resetPeak();
+        auto begin = std::chrono::steady_clock::now();
+        parser.parse(json);
+        auto end = std::chrono::steady_clock::now();
+        size_t peak = Memory::peakSinceReset(baseline);
+        double seconds = std::chrono::duration<double>(end - begin).count();
+        assert(parser.array().size() > 0);
+        return {static_cast<double>(json.size()) / (1024.0 * 1024.0) / seconds, peak};
+    }
+
     void test1() {
         std::cout << "\nTest 1: Basic Operations\n" << std::flush;
         std::cout << "------------------------\n" << std::flush;
@@ -73,12 +210,812 @@ namespace Test_Performance {
         assert(false); // Should have thrown exception
     }
 
+    void test5() {
+        std::cout << "\nTest 5: Single-pass vs Two-pass Parsing\n" << std::flush;
+        std::cout << "---------------------------------------\n" << std::flush;
+
+        std::string json = makeRecords(50000);
+        std::cout << "Input size: " << json.size() / 1024 << " KiB\n" << std::flush;
+        auto single = measureParse(json, Json::JParser::SinglePass);
+        auto two = measureParse(json, Json::JParser::TwoPass);
+        std::cout << "Single-pass: " << single.mb_per_sec << " MiB/s, peak heap "
+                  << single.peak_bytes / 1024 << " KiB\n" << std::flush;
+        std::cout << "Two-pass:    " << two.mb_per_sec << " MiB/s, peak heap "
+                  << two.peak_bytes / 1024 << " KiB\n" << std::flush;
+        std::cout << "Throughput ratio: " << single.mb_per_sec / two.mb_per_sec
+                  << "x, peak memory ratio: "
+                  << static_cast<double>(two.peak_bytes) / static_cast<double>(single.peak_bytes) << "x\n"
+                  << std::flush;
+        assert(single.peak_bytes < two.peak_bytes);
+    }
+
+    void test6() {
+        std::cout << "\nTest 6: Two-pass Tokenizer Throughput\n" << std::flush;
+        std::cout << "-------------------------------------\n" << std::flush;
+
+        std::string json = makeRecords(100000);
+        size_t tokens = countTokens(json);
+        Json::JParser parser;
+        parser.setParseMode(Json::JParser::TwoPass);
+        double best = 0;
+        for (int round = 0; round < 3; ++round) {
+            auto begin = std::chrono::steady_clock::now();
+            parser.parse(json);
+            auto end = std::chrono::steady_clock::now();
+            best = std::max(best, static_cast<double>(tokens) / std::chrono::duration<double>(end - begin).count());
+        }
+        assert(parser.array().size() == 100000);
+        std::cout << "Tokens: " << tokens << ", best of 3: " << best / 1e6 << " M tokens/s\n" << std::flush;
+    }
+
+    void test7() {
+        std::cout << "\nTest 7: Text-heavy Parsing\n" << std::flush;
+        std::cout << "--------------------------\n" << std::flush;
+
+        std::string text;
+        for (int i = 0; i < 100; ++i) text += "lorem ipsum {dolor} [sit], amet: ";
+        std::string json = "[";
+        for (int i = 0; i < 3000; ++i) {
+            json += "\"" + text + "\"";
+            json += (i + 1 < 3000) ? ", " : "]";
+        }
+        for (auto mode : {Json::JParser::SinglePass, Json::JParser::TwoPass}) {
+            Json::JParser parser;
+            parser.setParseMode(mode);
+            double best = 0;
+            for (int round = 0; round < 3; ++round) {
+                auto begin = std::chrono::steady_clock::now();
+                parser.parse(json);
+                auto end = std::chrono::steady_clock::now();
+                best = std::max(best, static_cast<double>(json.size()) / (1024.0 * 1024.0) /
+                                      std::chrono::duration<double>(end - begin).count());
+            }
+            assert(parser.array().size() == 3000);
+            std::cout << (mode == Json::JParser::SinglePass ? "Single-pass: " : "Two-pass:    ")
+                      << best << " MiB/s\n" << std::flush;
+        }
+    }
+
+    /// 只统计 "score" 字段的 Handler，用于对比事件式解析与构建完整树的开销
+    class ScoreSum : public Json::JHandler {
+    public:
+        bool onKey(std::string_view key) override {
+            _in_score = (key == "score");
+            return true;
+        }
+
+        bool onDouble(double value) override {
+            if (_in_score) sum += value;
+            return true;
+        }
+
+        double sum{0};
+    private:
+        bool _in_score{false};
+    };
+
+    void test8() {
+        std::cout << "\nTest 8: Event Handler vs Tree Parsing\n" << std::flush;
+        std::cout << "-------------------------------------\n" << std::flush;
+
+        std::string json = makeRecords(50000);
+        size_t baseline = Memory::current.load();
+        Memory::resetPeak();
+        auto begin = std::chrono::steady_clock::now();
+        ScoreSum handler;
+        bool completed = Json::JParser::parse(json, handler);
+        auto end = std::chrono::steady_clock::now();
+        size_t handler_peak = Memory::peakSinceReset(baseline);
+        double handler_speed = static_cast<double>(json.size()) / (1024.0 * 1024.0) /
+                               std::chrono::duration<double>(end - begin).count();
+        assert(completed);
+        assert(handler.sum == 50000 * 0.5 + 500 * (99 * 100 / 2));
+
+        auto tree = measureParse(json, Json::JParser::SinglePass);
+        std::cout << "Handler: " << handler_speed << " MiB/s, peak heap " << handler_peak / 1024 << " KiB\n"
+                  << std::flush;
+        std::cout << "Tree:    " << tree.mb_per_sec << " MiB/s, peak heap " << tree.peak_bytes / 1024 << " KiB\n"
+                  << std::flush;
+        assert(handler_peak < tree.peak_bytes);
+    }
+
+    void test9() {
+        std::cout << "\nTest 9: Chunked Stream Parsing\n" << std::flush;
+        std::cout << "------------------------------\n" << std::flush;
+
+        std::string json = makeRecords(50000);
+        for (size_t chunk : {size_t(4096), size_t(65536), json.size()}) {
+            ScoreSum handler;
+            Json::JStreamParser stream(handler);
+            size_t baseline = Memory::current.load();
+            Memory::resetPeak();
+            auto begin = std::chrono::steady_clock::now();
+            for (size_t pos = 0; pos < json.size(); pos += chunk) {
+                stream.feed(json.data() + pos, std::min(chunk, json.size() - pos));
+            }
+            stream.finish();
+            auto end = std::chrono::steady_clock::now();
+            size_t peak = Memory::peakSinceReset(baseline);
+            assert(handler.sum == 50000 * 0.5 + 500 * (99 * 100 / 2));
+            std::cout << "Chunk " << chunk / 1024 << " KiB: "
+                      << static_cast<double>(json.size()) / (1024.0 * 1024.0) /
+                         std::chrono::duration<double>(end - begin).count()
+                      << " MiB/s, peak heap " << peak << " bytes\n" << std::flush;
+        }
+    }
+
+    void test10() {
+        std::cout << "\nTest 10: JSON Lines Throughput\n" << std::flush;
+        std::cout << "------------------------------\n" << std::flush;
+
+        std::string text;
+        for (size_t i = 0; i < 200000; ++i) {
+            text += "{\"id\": " + std::to_string(i) + ", \"level\": \"info\", \"message\": \"request " +
+                    std::to_string(i) + " handled\", \"latency\": " + std::to_string(i % 1000) + ".25}\n";
+        }
+        reportScaling(text.size(), [&text](size_t threads) {
+            Json::JLinesParser parser(threads);
+            size_t count = 0;
+            auto begin = std::chrono::steady_clock::now();
+            parser.parse(text, [&count](Json::JLine& line) {
+                assert(line.error.empty());
+                count++;
+            });
+            auto end = std::chrono::steady_clock::now();
+            assert(count == 200000);
+            return std::chrono::duration<double>(end - begin).count();
+        });
+    }
+
+    void test11() {
+        std::cout << "\nTest 11: Parallel Array Parsing\n" << std::flush;
+        std::cout << "-------------------------------\n" << std::flush;
+
+        std::string json = makeRecords(200000);
+        reportScaling(json.size(), [&json](size_t threads) {
+            Json::JParser parser;
+            parser.setThreads(threads);
+            auto begin = std::chrono::steady_clock::now();
+            parser.parse(json);
+            auto end = std::chrono::steady_clock::now();
+            assert(parser.array().size() == 200000);
+            return std::chrono::duration<double>(end - begin).count();
+        });
+    }
+
+    void test12() {
+        std::cout << "\nTest 12: Loading a Large File\n" << std::flush;
+        std::cout << "-----------------------------\n" << std::flush;
+
+        std::string file_name = "performance_records.json";
+        std::string json = makeRecords(200000);
+        {
+            std::ofstream file(file_name, std::ios::out | std::ios::binary);
+            file << json;
+        }
+        Json::JParser parser;
+        size_t baseline = Memory::current.load();
+        Memory::resetPeak();
+        auto begin = std::chrono::steady_clock::now();
+        bool loaded = parser.parseFromJsonFile(file_name);
+        auto end = std::chrono::steady_clock::now();
+        size_t peak = Memory::peakSinceReset(baseline);
+        assert(loaded);
+        assert(parser.array().size() == 200000);
+        std::cout << "File size: " << json.size() / 1024 << " KiB, "
+                  << static_cast<double>(json.size()) / (1024.0 * 1024.0) /
+                     std::chrono::duration<double>(end - begin).count()
+                  << " MiB/s, peak heap " << peak / 1024 << " KiB\n" << std::flush;
+        remove(file_name.c_str());
+    }
+
+    void test13() {
+        std::cout << "\nTest 13: Numeric-heavy Parsing\n" << std::flush;
+        std::cout << "------------------------------\n" << std::flush;
+
+        std::string json = "[";
+        for (int i = 0; i < 200000; ++i) {
+            json += "[" + std::to_string(i) + ", " + std::to_string(i * 7919LL * 104729LL) + ", " +
+                    std::to_string(i % 1000) + "." + std::to_string(i % 97) + ", -" + std::to_string(i % 50) +
+                    ".125e-3, " + std::to_string(i % 3) + "]";
+            json += (i + 1 < 200000) ? "," : "]";
+        }
+        Json::JParser parser;
+        double best = 0;
+        for (int round = 0; round < 3; ++round) {
+            auto begin = std::chrono::steady_clock::now();
+            parser.parse(json);
+            auto end = std::chrono::steady_clock::now();
+            best = std::max(best, static_cast<double>(json.size()) / (1024.0 * 1024.0) /
+                                  std::chrono::duration<double>(end - begin).count());
+        }
+        assert(parser.array().size() == 200000);
+        std::cout << "Numbers: 1000000, best of 3: " << best << " MiB/s\n" << std::flush;
+    }
+
+    void test14() {
+        std::cout << "\nTest 14: String-heavy Parsing\n" << std::flush;
+        std::cout << "-----------------------------\n" << std::flush;
+
+        std::string plain(200, 'a');
+        std::string json = "[";
+        for (int i = 0; i < 20000; ++i) {
+            json += R"({"text": ")" + plain + R"(", "quote": "say \"hi\" to \u00e9l\u00e8ve \ud83d\ude00 )" +
+                    std::to_string(i) + R"(\n"})";
+            json += (i + 1 < 20000) ? "," : "]";
+        }
+        Json::JParser parser;
+        double best = 0;
+        for (int round = 0; round < 3; ++round) {
+            auto begin = std::chrono::steady_clock::now();
+            parser.parse(json);
+            auto end = std::chrono::steady_clock::now();
+            best = std::max(best, static_cast<double>(json.size()) / (1024.0 * 1024.0) /
+                                  std::chrono::duration<double>(end - begin).count());
+        }
+        assert(parser.array().size() == 20000);
+        std::cout << "Strings: 40000, best of 3: " << best << " MiB/s\n" << std::flush;
+    }
+
+    // Keeps every string value; views are only kept when they point into an in-situ buffer
+    class StringKeeper : public Json::JHandler {
+    public:
+        explicit StringKeeper(bool keep_views) : _keep_views(keep_views) {}
+
+        bool onString(std::string_view value) override {
+            if (_keep_views)
+                views.push_back(value);
+            else
+                copies.emplace_back(value);
+            return true;
+        }
+
+        std::vector<std::string_view> views;
+        std::vector<std::string> copies;
+    private:
+        bool _keep_views;
+    };
+
+    void test15() {
+        std::cout << "\nTest 15: In-situ Parsing\n" << std::flush;
+        std::cout << "------------------------\n" << std::flush;
+
+        std::string json = "[";
+        for (int i = 0; i < 50000; ++i) {
+            json += R"({"message": "line one\nline two \"quoted\" and a longer tail )" + std::to_string(i) + R"("})";
+            json += (i + 1 < 50000) ? "," : "]";
+        }
+
+        StringKeeper copying(false);
+        copying.copies.reserve(50000);
+        size_t before = Test_Performance::Memory::allocations.load();
+        auto begin = std::chrono::steady_clock::now();
+        bool completed = Json::JParser::parse(json, copying);
+        auto end = std::chrono::steady_clock::now();
+        size_t copy_allocations = Test_Performance::Memory::allocations.load() - before;
+        double copy_speed = static_cast<double>(json.size()) / (1024.0 * 1024.0) /
+                            std::chrono::duration<double>(end - begin).count();
+
+        std::vector<char> buffer(json.begin(), json.end());
+        StringKeeper in_situ(true);
+        in_situ.views.reserve(50000);
+        before = Test_Performance::Memory::allocations.load();
+        begin = std::chrono::steady_clock::now();
+        completed = completed && Json::JParser::parseInSitu(buffer.data(), buffer.size(), in_situ);
+        end = std::chrono::steady_clock::now();
+        size_t in_situ_allocations = Test_Performance::Memory::allocations.load() - before;
+        double in_situ_speed = static_cast<double>(json.size()) / (1024.0 * 1024.0) /
+                               std::chrono::duration<double>(end - begin).count();
+
+        assert(completed);
+        assert(in_situ.views.size() == copying.copies.size());
+        assert(in_situ.views.back() == copying.copies.back());
+        std::cout << "Copying strings: " << copy_speed << " MiB/s, " << copy_allocations << " allocations\n"
+                  << std::flush;
+        std::cout << "In-situ views:   " << in_situ_speed << " MiB/s, " << in_situ_allocations << " allocations\n"
+                  << std::flush;
+        assert(in_situ_allocations < copy_allocations);
+
+        // Every string here contains escapes, so a retained document still decodes them into its arena
+        Json::JDocument copied, retained, borrowed;
+        copied.parse(json);
+        retained.parseRetained(json);
+        buffer.assign(json.begin(), json.end());
+        begin = std::chrono::steady_clock::now();
+        borrowed.parseInSitu(buffer.data(), buffer.size());
+        end = std::chrono::steady_clock::now();
+        std::cout << "In-situ document: " << static_cast<double>(json.size()) / (1024.0 * 1024.0) /
+                                             std::chrono::duration<double>(end - begin).count()
+                  << " MiB/s, arena " << borrowed.reservedBytes() / 1024 << " KiB (parse "
+                  << copied.reservedBytes() / 1024 << " KiB, parseRetained " << retained.reservedBytes() / 1024
+                  << " KiB)\n" << std::flush;
+        assert(borrowed.reservedBytes() < retained.reservedBytes());
+    }
+
+    void test16() {
+        std::cout << "\nTest 16: Compact Node Tree\n" << std::flush;
+        std::cout << "--------------------------\n" << std::flush;
+
+        std::string json = makeRecords(100000);
+        size_t baseline = Memory::current.load();
+        auto begin = std::chrono::steady_clock::now();
+        Json::JParser parser;
+        parser.parse(json);
+        auto end = std::chrono::steady_clock::now();
+        size_t tree_bytes = Memory::current.load() - baseline;
+        double tree_speed = static_cast<double>(json.size()) / (1024.0 * 1024.0) /
+                            std::chrono::duration<double>(end - begin).count();
+
+        baseline = Memory::current.load();
+        begin = std::chrono::steady_clock::now();
+        Json::JNode root = Json::JParser::parseNode(json);
+        end = std::chrono::steady_clock::now();
+        size_t node_bytes = Memory::current.load() - baseline;
+        double node_speed = static_cast<double>(json.size()) / (1024.0 * 1024.0) /
+                            std::chrono::duration<double>(end - begin).count();
+
+        // The compact tree saves memory; neither parser is reliably faster, so only the size is asserted
+        assert(root.size() == parser.array().size());
+        std::cout << "Input:       " << json.size() / 1024 << " KiB\n" << std::flush;
+        std::cout << "JValue tree: " << tree_bytes / 1024 << " KiB retained (parsed at " << tree_speed
+                  << " MiB/s)\n" << std::flush;
+        std::cout << "JNode tree:  " << node_bytes / 1024 << " KiB retained (parsed at " << node_speed
+                  << " MiB/s)\n" << std::flush;
+        assert(node_bytes < tree_bytes);
+    }
+
+    void test17() {
+        std::cout << "\nTest 17: Parse and Discard\n" << std::flush;
+        std::cout << "--------------------------\n" << std::flush;
+
+        std::string json = makeRecords(200);
+        constexpr int rounds = 2000;
+        auto report = [&](const char* name, const std::function<void()>& parse_once) {
+            size_t before = Memory::allocations.load();
+            auto begin = std::chrono::steady_clock::now();
+            for (int i = 0; i < rounds; ++i) parse_once();
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - begin).count();
+            size_t allocations = (Memory::allocations.load() - before) / rounds;
+            std::cout << name << rounds / seconds << " documents/s, " << allocations << " allocations each\n"
+                      << std::flush;
+            return allocations;
+        };
+
+        size_t tree = report("JParser:   ", [&] {
+            Json::JParser parser;
+            parser.parse(json);
+        });
+        size_t nodes = report("parseNode: ", [&] {
+            Json::JNode root = Json::JParser::parseNode(json);
+        });
+        Json::JDocument document;
+        size_t arena = report("JDocument: ", [&] {
+            document.parse(json);
+        });
+        assert(document.root().size() == 200);
+        // parseNode allocates every string and container on its own, more often than the tree's exact-size storage
+        assert(arena < tree && arena < nodes);
+    }
+
+    void test18() {
+        std::cout << "\nTest 18: Field Extraction\n" << std::flush;
+        std::cout << "-------------------------\n" << std::flush;
+
+        Json::JObject request;
+        request.set("id", 42);
+        request.set("user", "someone");
+        request.set("score", 0.5);
+        request.set("admin", false);
+        constexpr int rounds = 1000000;
+        int64_t checksum = 0;
+        size_t before = Memory::allocations.load();
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < rounds; ++i) {
+            checksum += request.toInt("id");
+            checksum += static_cast<int64_t>(request.toString("user").size());
+            checksum += request.toDouble("score") > 0 ? 1 : 0;
+            checksum += request.toBool("admin") ? 1 : 0;
+        }
+        auto end = std::chrono::steady_clock::now();
+        size_t allocations = Memory::allocations.load() - before;
+        double seconds = std::chrono::duration<double>(end - begin).count();
+        std::cout << "Literal key reads: " << rounds * 4 / seconds / 1e6 << " M/s, "
+                  << allocations << " allocations\n" << std::flush;
+        assert(checksum == int64_t(rounds) * 50);
+        assert(allocations == 0);
+    }
+
+    void test19() {
+        std::cout << "\nTest 19: Bottom-up Tree Building\n" << std::flush;
+        std::cout << "--------------------------------\n" << std::flush;
+
+        constexpr int groups = 100, rows = 1000;
+        auto build = [&](const char* name, bool move) {
+            size_t before = Memory::allocations.load();
+            auto begin = std::chrono::steady_clock::now();
+            Json::JObject report;
+            for (int g = 0; g < groups; ++g) {
+                Json::JArray group;
+                for (int r = 0; r < rows; ++r) {
+                    Json::JObject row;
+                    row.set("id", r);
+                    row.set("name", "row");
+                    Json::JArray cells;
+                    for (int c = 0; c < 4; ++c) cells.pushBack(c);
+                    if (move) {
+                        row.set("cells", std::move(cells));
+                        group.pushBack(std::move(row));
+                    } else {
+                        row.set("cells", cells);
+                        group.pushBack(row);
+                    }
+                }
+                if (move)
+                    report.set("group" + std::to_string(g), std::move(group));
+                else
+                    report.set("group" + std::to_string(g), group);
+            }
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - begin).count();
+            size_t allocations = Memory::allocations.load() - before;
+            std::cout << name << seconds * 1000 << " ms, " << allocations << " allocations\n" << std::flush;
+            assert(report.size() == groups && report.toArray("group0")->size() == rows);
+            return allocations;
+        };
+
+        size_t copied = build("Copying children: ", false);
+        size_t moved = build("Moving children:  ", true);
+        // Copies share storage (copy-on-write), so a copied child costs no more allocations than a moved one.
+        // Each row needs its entry buffer (3 growths), its cells buffer (3 growths) and two shared_ptr blocks.
+        assert(moved <= copied);
+        assert(moved < size_t(groups) * rows * 9);
+    }
+
+    void test20() {
+        std::cout << "\nTest 20: Copy-on-write Snapshots\n" << std::flush;
+        std::cout << "--------------------------------\n" << std::flush;
+
+        Json::JObject config;
+        for (int i = 0; i < 10000; ++i) {
+            Json::JObject &service = config.emplaceObject("service" + std::to_string(i));
+            service.set("enabled", true);
+            service.emplaceArray("limits") << 100 << 200;
+        }
+        constexpr int rounds = 1000;
+        std::vector<Json::JObject> versions;
+        versions.reserve(rounds);
+        size_t before = Memory::allocations.load();
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < rounds; ++i) versions.push_back(config);
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - begin).count();
+        std::cout << "Snapshot: " << seconds * 1e9 / rounds << " ns, "
+                  << (Memory::allocations.load() - before) << " allocations in total\n" << std::flush;
+        assert(Memory::allocations.load() == before);
+
+        // The first write after a snapshot copies one level of the root (10000 members) and the modified child
+        begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < rounds; ++i) {
+            Json::JObject version = versions[i];
+            std::get<std::shared_ptr<Json::JObject>>(version["service" + std::to_string(i)])->set("enabled", false);
+            versions[i] = std::move(version);
+        }
+        end = std::chrono::steady_clock::now();
+        seconds = std::chrono::duration<double>(end - begin).count();
+        std::cout << "First write after a snapshot: " << seconds * 1e6 / rounds << " us\n" << std::flush;
+        assert(config.toObject("service0")->toBool("enabled"));
+        assert(!versions[0].toObject("service0")->toBool("enabled"));
+        assert(versions[1].toObject("service0")->toBool("enabled"));
+    }
+
+    void test21() {
+        std::cout << "\nTest 21: Frozen Lookups\n" << std::flush;
+        std::cout << "-----------------------\n" << std::flush;
+
+        Json::JObject config;
+        std::vector<std::string> keys;
+        for (int i = 0; i < 50000; ++i) {
+            keys.push_back("setting_" + std::to_string(i));
+            Json::JObject &section = config.emplaceObject(keys.back());
+            for (int j = 0; j < 12; ++j) section.set("field_" + std::to_string(j), i + j);
+        }
+        Json::JDocument frozen;
+        frozen.freeze(config);
+        // Random order so that reads miss the cache as they would on a large live config
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+
+        constexpr int rounds = 10;
+        auto measure = [&](const char* name, const std::function<int64_t(const std::string&)>& read) {
+            int64_t checksum = 0;
+            auto begin = std::chrono::steady_clock::now();
+            for (int r = 0; r < rounds; ++r) {
+                for (auto &key : keys) checksum += read(key);
+            }
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - begin).count();
+            std::cout << name << seconds * 1e9 / (rounds * keys.size()) << " ns per nested read\n" << std::flush;
+            return checksum;
+        };
+
+        int64_t tree = measure("JObject:  ", [&](const std::string& key) {
+            return config.toObject(key)->toInt("field_11");
+        });
+        int64_t node = measure("Frozen:   ", [&](const std::string& key) {
+            return Json::JGet::toInt(frozen.root().get(key).get("field_11"));
+        });
+        assert(tree == node);
+    }
+
+    void test22() {
+        std::cout << "\nTest 22: Packed Numeric Arrays\n" << std::flush;
+        std::cout << "------------------------------\n" << std::flush;
+
+        constexpr int count = 1000000;
+        std::string json = "[";
+        std::mt19937 random(7);
+        std::uniform_real_distribution<double> sample(-1000.0, 1000.0);
+        for (int i = 0; i < count; ++i) {
+            if (i) json += ", ";
+            json += std::to_string(sample(random));
+        }
+        json += "]";
+
+        size_t baseline = Memory::current.load();
+        Json::JParser parser;
+        parser.parse(json);
+        const Json::JArray &packed = parser.array();
+        size_t packed_bytes = Memory::current.load() - baseline;
+        assert(packed.doubles().size() == count);
+
+        baseline = Memory::current.load();
+        Json::JArray plain = packed;
+        (void) plain[0];
+        size_t plain_bytes = Memory::current.load() - baseline;
+        assert(plain.doubles().empty());
+        std::cout << "Memory: packed " << packed_bytes / 1024 << " KiB, per-element values "
+                  << plain_bytes / 1024 << " KiB\n" << std::flush;
+
+        constexpr int rounds = 20;
+        auto measure = [&](const char* name, const std::function<double()>& reduce) {
+            double result = 0;
+            auto begin = std::chrono::steady_clock::now();
+            for (int r = 0; r < rounds; ++r) result += reduce();
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - begin).count();
+            std::cout << name << seconds * 1e9 / (rounds * static_cast<double>(count)) << " ns per element\n"
+                      << std::flush;
+            return result;
+        };
+        double loop = measure("Loop over JValue: ", [&]() {
+            double sum = 0;
+            for (auto &value : std::as_const(plain)) sum += std::get<double>(value);
+            return sum;
+        });
+        double reduced = measure("Packed sum():     ", [&]() { return packed.sum(); });
+
+        // Read-only iteration builds one element at a time; only get() expands and keeps the whole array
+        baseline = Memory::current.load();
+        double visited = 0;
+        for (const auto &value : packed) visited += std::get<double>(value);
+        visited += packed.isNull(0) ? 1 : 0;
+        size_t read_bytes = Memory::current.load() - baseline;
+        (void) packed.get(0);
+        size_t cached_bytes = Memory::current.load() - baseline;
+        std::cout << "Extra memory: read-only iteration " << read_bytes / 1024 << " KiB, after get() "
+                  << cached_bytes / 1024 << " KiB\n" << std::flush;
+        assert(read_bytes == 0 && cached_bytes >= count * sizeof(Json::JValue));
+        assert(std::abs(visited - reduced / rounds) < 1e-6 * count);
+        (void) visited;
+        // Different summation order, so only close
+        assert(std::abs(loop - reduced) < 1e-6 * count);
+        assert(packed.min() >= -1000.0 && packed.max() <= 1000.0 && packed.min() == plain.min());
+        assert(parser.dump() == Json::JParser(plain).dump());
+    }
+
+    void test23() {
+        std::cout << "\nTest 23: Streaming Serialization\n" << std::flush;
+        std::cout << "--------------------------------\n" << std::flush;
+
+        Json::JArray rows;
+        for (int i = 0; i < 200000; ++i) {
+            Json::JObject &row = rows.emplaceObject();
+            row.set("id", i);
+            row.set("name", "user_" + std::to_string(i));
+            Json::JObject &address = row.emplaceObject("address");
+            address.set("city", "city_" + std::to_string(i % 100));
+            address.emplaceObject("geo").emplaceArray("point") << i << -i;
+        }
+        Json::JParser parser(rows);
+
+        auto measure = [&](const char* name, const std::function<size_t()>& write) {
+            size_t baseline = Memory::current.load();
+            Memory::resetPeak();
+            auto begin = std::chrono::steady_clock::now();
+            size_t bytes = write();
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - begin).count();
+            std::cout << name << bytes / seconds / 1024 / 1024 << " MiB/s, peak memory "
+                      << Memory::peakSinceReset(baseline) / 1024 << " KiB\n" << std::flush;
+            return bytes;
+        };
+        size_t in_memory = measure("dump() to string:   ", [&]() { return parser.dump(2).size(); });
+        size_t streamed = measure("JWriter to a file:  ", [&]() {
+            std::ofstream file("performance_writer.json", std::ios::out | std::ios::binary);
+            Json::JWriter writer(file, 2);
+            parser.dump(writer);
+            writer.flush();
+            return static_cast<size_t>(file.tellp());
+        });
+        std::remove("performance_writer.json");
+        assert(in_memory == streamed);
+    }
+
+    void test24() {
+        std::cout << "\nTest 24: Compact Output\n" << std::flush;
+        std::cout << "-----------------------\n" << std::flush;
+
+        Json::JArray rows;
+        for (int i = 0; i < 100000; ++i) {
+            Json::JObject &row = rows.emplaceObject();
+            row.set("id", i);
+            row.set("active", i % 2 == 0);
+            row.set("name", "user_" + std::to_string(i));
+            row.emplaceObject("meta").emplaceArray("tags") << "a" << "b";
+        }
+        Json::JParser parser(rows);
+
+        constexpr int rounds = 5;
+        auto measure = [&](const char* name, uint8_t space) {
+            size_t bytes = 0;
+            auto begin = std::chrono::steady_clock::now();
+            for (int r = 0; r < rounds; ++r) bytes = parser.dump(space).size();
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - begin).count() / rounds;
+            std::cout << name << bytes / 1024 << " KiB, " << seconds * 1e3 << " ms\n" << std::flush;
+            return bytes;
+        };
+        size_t pretty = measure("dump(2): ", 2);
+        size_t compact = measure("dump(0): ", 0);
+        assert(compact < pretty);
+    }
+
+    void test25() {
+        std::cout << "\nTest 25: Floating-point Output\n" << std::flush;
+        std::cout << "------------------------------\n" << std::flush;
+
+        constexpr int count = 1000000;
+        Json::JArray metrics;
+        std::mt19937 random(11);
+        std::uniform_real_distribution<double> sample(0.0, 1e6);
+        std::vector<double> values;
+        for (int i = 0; i < count; ++i) {
+            values.push_back(sample(random));
+            metrics << values.back();
+        }
+        Json::JParser parser(metrics);
+
+        // The previous formatting: std::to_string (printf "%f") and trailing zeros trimmed
+        auto begin = std::chrono::steady_clock::now();
+        std::string previous;
+        for (double value : values) {
+            auto text = std::to_string(value);
+            text.erase(text.find_last_not_of('0') + 1, std::string::npos);
+            if (text.back() == '.') text.pop_back();
+            previous += text;
+            previous += ',';
+        }
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - begin).count();
+        std::cout << "to_string and trim:  " << seconds * 1e9 / count << " ns per number\n" << std::flush;
+
+        begin = std::chrono::steady_clock::now();
+        std::string output = parser.dump(0);
+        end = std::chrono::steady_clock::now();
+        seconds = std::chrono::duration<double>(end - begin).count();
+        std::cout << "dump(0), to_chars:   " << seconds * 1e9 / count << " ns per number\n" << std::flush;
+
+        Json::JParser reparsed;
+        reparsed.parse(output);
+        for (int i = 0; i < count; i += 997) assert(reparsed.array().toDouble(i) == values[i]);
+    }
+
+    void test26() {
+        std::cout << "\nTest 26: String Escaping\n" << std::flush;
+        std::cout << "------------------------\n" << std::flush;
+
+        constexpr int count = 200000;
+        Json::JArray texts;
+        std::vector<std::string> values;
+        size_t bytes = 0;
+        for (int i = 0; i < count; ++i) {
+            // Mostly clean text; every 16th string carries a newline and a quote
+            std::string value = "user comment number " + std::to_string(i) + " with some ordinary text in it";
+            if (i % 16 == 0) value += "\n\"quoted\"";
+            bytes += value.size();
+            values.push_back(value);
+            texts << value;
+        }
+        Json::JParser parser(texts);
+
+        // The previous escaping: one switch per character
+        auto begin = std::chrono::steady_clock::now();
+        std::string previous;
+        for (const auto &value : values) {
+            previous += '"';
+            for (char c : value) {
+                switch (c) {
+                    case '"': previous += "\\\""; break;
+                    case '\\': previous += "\\\\"; break;
+                    case '\n': previous += "\\n"; break;
+                    case '\t': previous += "\\t"; break;
+                    default: previous += c; break;
+                }
+            }
+            previous += "\",";
+        }
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - begin).count();
+        std::cout << "Per-character loop:  " << bytes / seconds / 1e6 << " MB/s\n" << std::flush;
+
+        begin = std::chrono::steady_clock::now();
+        std::string output = parser.dump(0);
+        end = std::chrono::steady_clock::now();
+        seconds = std::chrono::duration<double>(end - begin).count();
+        std::cout << "dump(0), SIMD scan:  " << bytes / seconds / 1e6 << " MB/s\n" << std::flush;
+
+        assert(output.size() == previous.size() + 1);
+        Json::JParser reparsed;
+        reparsed.parse(output);
+        for (int i = 0; i < count; i += 997) assert(reparsed.array().toString(i) == values[i]);
+    }
+
+    void test27() {
+        std::cout << "\nTest 27: Parallel Serialization\n" << std::flush;
+        std::cout << "-------------------------------\n" << std::flush;
+
+        Json::JParser parser;
+        parser.parse(makeRecords(200000));
+        std::string expected = parser.dump(0);
+        reportScaling(expected.size(), [&parser, &expected](size_t threads) {
+            parser.setThreads(threads);
+            auto begin = std::chrono::steady_clock::now();
+            std::string output = parser.dump(0);
+            auto end = std::chrono::steady_clock::now();
+            assert(output == expected);
+            return std::chrono::duration<double>(end - begin).count();
+        });
+    }
+
     int start() {
         std::cout << "\nPerformance Tests Started\n" << std::flush;
         test1();
         test2();
         test3();
         test4();
+        test5();
+        test6();
+        test7();
+        test8();
+        test9();
+        test10();
+        test11();
+        test12();
+        test13();
+        test14();
+        test15();
+        test16();
+        test17();
+        test18();
+        test19();
+        test20();
+        test21();
+        test22();
+        test23();
+        test24();
+        test25();
+        test26();
+        test27();
         std::cout << "\nAll Performance Tests Completed\n" << std::flush;
         return 0;
     }